@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2023 HAW Hamburg
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""
+Reports the ROM and RAM footprint of every registry schema of a build.
+
+The object file of every schema is split into its mapping code, the schema
+struct, its schema items and the strings of their names and descriptions. The
+type sizes are read from the debug information, which RIOT always generates,
+to count the items and to calculate the memory of an instance and of the
+entries the core adds to its name index. Schemas whose names and descriptions
+take up a big part of their ROM are flagged, because they profit the most from
+CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD and
+CONFIG_REGISTRY_DISABLE_SCHEMA_DESCRIPTION_FIELD.
+
+Usage: registry_footprint.py [--size SIZE] [--nm NM] [--readelf READELF]
+                             --core registry.o schema.o [schema.o ...]
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+# strings that are bigger than this share of the ROM of a schema are flagged
+STRINGS_SHARE_THRESHOLD = 1 / 3
+
+DIE_RE = re.compile(r"^\s*<\d+><([0-9a-f]+)>: Abbrev Number: \d+ \((DW_TAG_\w+)\)")
+ATTR_RE = re.compile(r"^\s*<[0-9a-f]+>\s+(DW_AT_\w+)\s*: (.*)$")
+
+
+def run(*cmd):
+    return subprocess.run(cmd, check=True, capture_output=True, text=True).stdout
+
+
+def section_sizes(size, obj):
+    """Returns the sizes of the sections of obj as printed by `size -A`"""
+    sections = {}
+    for line in run(size, "-A", obj).splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[0].startswith(".") and fields[1].isdigit():
+            sections[fields[0]] = int(fields[1])
+    return sections
+
+
+def data_symbols(nm, obj):
+    """Returns (name, type, size) of every sized data symbol of obj"""
+    symbols = []
+    for line in run(nm, "-S", obj).splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2] in "bBdDrR":
+            symbols.append((fields[3], fields[2], int(fields[1], 16)))
+    return symbols
+
+
+def type_sizes(readelf, obj):
+    """Returns the byte size of every named struct and typedef of the debug information of obj"""
+    dies = {}
+    die = None
+    for line in run(readelf, "--debug-dump=info", obj).splitlines():
+        match = DIE_RE.match(line)
+        if match:
+            die = dies.setdefault(int(match.group(1), 16), {"tag": match.group(2)})
+            continue
+        match = ATTR_RE.match(line)
+        if match and die is not None:
+            attr, value = match.groups()
+            if attr == "DW_AT_name":
+                die["name"] = value.split("): ")[-1].strip()
+            elif attr == "DW_AT_byte_size":
+                die["size"] = int(value.split()[0], 0)
+            elif attr == "DW_AT_type":
+                die["type"] = int(value.strip("<>"), 16)
+
+    def resolve(die, depth=0):
+        if "size" in die or depth > 8:
+            return die.get("size")
+        if die["tag"] == "DW_TAG_typedef" and die.get("type") in dies:
+            return resolve(dies[die["type"]], depth + 1)
+        return None
+
+    sizes = {}
+    for die in dies.values():
+        if "name" in die and die["tag"] in ("DW_TAG_typedef", "DW_TAG_structure_type"):
+            size = resolve(die)
+            if size is not None:
+                sizes.setdefault(die["name"], size)
+    return sizes
+
+
+def schema_footprint(tools, obj):
+    sections = section_sizes(tools.size, obj)
+    symbols = data_symbols(tools.nm, obj)
+    types = type_sizes(tools.readelf, obj)
+
+    schemas = [name for name, kind, _ in symbols if kind in "DR"]
+    name = schemas[0] if schemas else os.path.splitext(os.path.basename(obj))[0]
+    item_size = types.get("registry_schema_item_t")
+    instance_size = types.get("registry_instance_t")
+    data_size = types.get(name + "_t")
+
+    footprint = {
+        "name": name,
+        "code": sum(v for k, v in sections.items() if k.startswith(".text")),
+        "strings": sum(v for k, v in sections.items() if k.startswith(".rodata.str")),
+        "schema": sum(size for sym, kind, size in symbols if sym == name),
+        # the items of the schema and of its groups are compound literals
+        "items": sum(size for sym, _, size in symbols if sym.startswith("__compound_literal")),
+        "other": sum(size for sym, _, size in symbols
+                     if sym != name and not sym.startswith("__compound_literal")),
+    }
+    footprint["items_len"] = footprint["items"] // item_size if item_size else None
+    footprint["instance"] = instance_size + data_size if instance_size and data_size else None
+    footprint["rom"] = (footprint["code"] + footprint["strings"] + footprint["schema"] +
+                        footprint["items"] + footprint["other"])
+    # the items are not const, so they are copied to RAM at startup like the schema itself
+    footprint["ram"] = footprint["schema"] + footprint["items"] + footprint["other"]
+    return footprint
+
+
+def fmt(value):
+    return "?" if value is None else str(value)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--size", default="size")
+    parser.add_argument("--nm", default="nm")
+    parser.add_argument("--readelf", default="readelf")
+    parser.add_argument("--core", required=True, help="object file of the registry core")
+    parser.add_argument("schemas", nargs="+", help="object files of the schemas")
+    tools = parser.parse_args()
+
+    core_types = type_sizes(tools.readelf, tools.core)
+    entry_size = core_types.get("_registry_name_index_entry_t")
+
+    columns = ("schema", "code", "strings", "struct", "items", "rom", "ram",
+               "items_len", "instance", "index")
+    print("{:<36}".format(columns[0]) + "".join("{:>10}".format(c) for c in columns[1:]))
+
+    footprints = []
+    for obj in tools.schemas:
+        footprint = schema_footprint(tools, obj)
+        # the schema, each of its items and each instance take one entry of the name index
+        footprint["index"] = ((footprint["items_len"] + 1) * entry_size
+                              if entry_size and footprint["items_len"] is not None else None)
+        footprint["flagged"] = (footprint["rom"] > 0 and
+                                footprint["strings"] / footprint["rom"] > STRINGS_SHARE_THRESHOLD)
+        footprints.append(footprint)
+
+        print("{:<36}".format(footprint["name"] + (" *" if footprint["flagged"] else "")) +
+              "".join("{:>10}".format(fmt(footprint[k])) for k in
+                      ("code", "strings", "schema", "items", "rom", "ram",
+                       "items_len", "instance", "index")))
+
+    print()
+    print("rom/ram: memory of the schema itself, instance: RAM per instance including its "
+          "data, index: name index entries of the schema")
+    if entry_size:
+        print("every instance takes another {} bytes of the name index".format(entry_size))
+
+    print()
+    print("core structures (RAM):")
+    for sym, kind, size in sorted(data_symbols(tools.nm, tools.core), key=lambda s: -s[2]):
+        # read-only symbols like the function names of assert() stay in ROM
+        if kind in "bBdD" and size > 0:
+            print("  {:<34}{:>10}".format(sym, size))
+
+    footprints.sort(key=lambda f: -f["strings"])
+    if footprints and footprints[0]["strings"] > 0:
+        print()
+        print("CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD and _DESCRIPTION_FIELD save up to:")
+        for footprint in footprints:
+            print("  {:<34}{:>10}{}".format(footprint["name"], footprint["strings"],
+                                           " *" if footprint["flagged"] else ""))
+        print("* names and descriptions take more than {:.0%} of the ROM of the schema"
+              .format(STRINGS_SHARE_THRESHOLD))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -54,6 +54,83 @@ extern "C" {
                                    (REGISTRY_MAX_DIR_DEPTH - 1))
 /** @} */
 
+/**
+ * @brief Size of the index that tracks already loaded parameters, when loading
+ * from multiple sources. Must be a power of two.
+ */
+#ifndef CONFIG_REGISTRY_LOAD_INDEX_SIZE
+#define CONFIG_REGISTRY_LOAD_INDEX_SIZE 128
+#endif
+
+/**
+ * @brief Size of the index that maps the names of schemas, instances and schema items to their
+ * ids for @ref registry_path_from_names(). Must be a power of two and bigger than the amount of
+ * registered names, that is one per schema, instance and schema item (groups and parameters).
+ * Names that do not fit can not be resolved, and their registration returns -ENOMEM.
+ */
+#ifndef CONFIG_REGISTRY_NAME_INDEX_SIZE
+#define CONFIG_REGISTRY_NAME_INDEX_SIZE 64
+#endif
+
+/**
+ * @brief Enable lazy loading. Instead of loading everything with @ref registry_load() at boot,
+ * the values of an instance are loaded from the storage facilities when the instance is
+ * accessed through the registry for the first time.
+ * Reading the data of an instance directly bypasses this, so it has to be loaded explicitly then.
+ */
+#ifndef CONFIG_REGISTRY_LAZY_LOAD
+#define CONFIG_REGISTRY_LAZY_LOAD 0
+#endif
+
+/**
+ * @brief Enable statistics. The registry counts the calls and errors of its operations and
+ * measures their latencies, which can be read with @ref registry_stats_get().
+ * Measuring the latencies requires the ztimer_usec module.
+ */
+#ifndef CONFIG_REGISTRY_STATS
+#define CONFIG_REGISTRY_STATS 0
+#endif
+
+/**
+ * @brief Amount of buckets of the latency histograms. Bucket i counts the latencies below
+ * 2^i microseconds, the last bucket counts all remaining latencies.
+ * The latencies are 32 bit, so at most 33 buckets are allowed.
+ */
+#ifndef CONFIG_REGISTRY_STATS_HISTOGRAM_BUCKETS
+#define CONFIG_REGISTRY_STATS_HISTOGRAM_BUCKETS 16
+#endif
+
+/**
+ * @brief Amount of storage facilities whose latencies are measured separately.
+ */
+#ifndef CONFIG_REGISTRY_STATS_STORAGE_FACILITIES
+#define CONFIG_REGISTRY_STATS_STORAGE_FACILITIES 4
+#endif
+
+/**
+ * @brief Enable tracing. The registry records set, commit, load and save calls in a ring buffer,
+ * which can be drained with @ref registry_trace_drain().
+ * Recording the timestamps requires the ztimer_msec module.
+ */
+#ifndef CONFIG_REGISTRY_TRACE
+#define CONFIG_REGISTRY_TRACE 0
+#endif
+
+/**
+ * @brief Amount of events the trace ring buffer can hold. Must be a power of two.
+ */
+#ifndef CONFIG_REGISTRY_TRACE_SIZE
+#define CONFIG_REGISTRY_TRACE_SIZE 32
+#endif
+
+/**
+ * @brief Amount of ids after the namespace id (schema, instance and schema items) that are
+ * recorded per trace event. Longer paths are truncated.
+ */
+#ifndef CONFIG_REGISTRY_TRACE_PATH_LEN
+#define CONFIG_REGISTRY_TRACE_PATH_LEN 5
+#endif
+
 /**
  * @brief Calculates the size of an @ref registry_schema_item_t array.
  *
@@ -75,98 +152,95 @@ extern "C" {
         .items_len = _REGISTRY_SCHEMA_ITEM_NUMARGS(__VA_ARGS__), \
     }
 
+/**
+ * @brief Initializes the strings of a @ref registry_schema_item_t with the enabled ones of
+ * @p _name and @p _description.
+ */
+#if IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD) && \
+    IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_DESCRIPTION_FIELD)
+/* no name and no description, the strings field does not exist */
+# define _REGISTRY_SCHEMA_ITEM_STRINGS(_name, _description)
+#elif IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD)
+/* no name */
+# define _REGISTRY_SCHEMA_ITEM_STRINGS(_name, _description) \
+    .strings = _description,
+#elif IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_DESCRIPTION_FIELD)
+/* no description */
+# define _REGISTRY_SCHEMA_ITEM_STRINGS(_name, _description) \
+    .strings = _name,
+#else
+/* keep name and description, both share one string literal */
+# define _REGISTRY_SCHEMA_ITEM_STRINGS(_name, _description) \
+    .strings = _name "\0" _description,
+#endif
+
 /**
  * @brief Creates and initializes a @ref registry_schema_item_t struct and defaults its type to @ref REGISTRY_SCHEMA_TYPE_GROUP.
- *
+ * @p _name and @p _description must be string literals.
  */
 #define REGISTRY_GROUP(_id, _name, _description, ...) \
     { \
+        _REGISTRY_SCHEMA_ITEM_STRINGS(_name, _description) \
+        .items = (registry_schema_item_t[]) { __VA_ARGS__ }, \
         .id = _id, \
-        .name = _name, \
-        .description = _description, \
-        .type = REGISTRY_SCHEMA_TYPE_GROUP, \
-        .value.group = { \
-            .items = (registry_schema_item_t[]) { __VA_ARGS__ }, \
-            .items_len = _REGISTRY_SCHEMA_ITEM_NUMARGS(__VA_ARGS__), \
-        }, \
+        .items_len = _REGISTRY_SCHEMA_ITEM_NUMARGS(__VA_ARGS__), \
+        .kind = REGISTRY_SCHEMA_TYPE_GROUP, \
     },
 
 /**
  * @brief Creates and initializes a @ref registry_schema_item_t struct and defaults its type to @ref REGISTRY_SCHEMA_TYPE_PARAMETER.
- *
+ * @p _name and @p _description must be string literals.
  */
 #define REGISTRY_PARAMETER(_id, _name, _description, _type) \
     { \
+        _REGISTRY_SCHEMA_ITEM_STRINGS(_name, _description) \
         .id = _id, \
-        .name = _name, \
-        .description = _description, \
-        .type = REGISTRY_SCHEMA_TYPE_PARAMETER, \
-        .value.parameter = { \
-            .type = _type, \
-        }, \
+        .kind = REGISTRY_SCHEMA_TYPE_PARAMETER, \
+        .value_type = _type, \
     },
 
-#if IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD) && \
-    IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_DESCRIPTION_FIELD)
-/* no name and no description */
-# define _REGISTRY_PARAMETER(_id, _name, _description, _type) \
-    REGISTRY_PARAMETER(_id, "", "", _type)
-#elif IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD)
-/* no name */
-# define _REGISTRY_PARAMETER(_id, _name, _description, _type) \
-    REGISTRY_PARAMETER(_id, "", _description, _type)
-#elif IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_DESCRIPTION_FIELD)
-/* no description */
-# define _REGISTRY_PARAMETER(_id, _name, _description, _type) \
-    REGISTRY_PARAMETER(_id, _name, "", _type)
-#else
-/* keep name and description */
-# define _REGISTRY_PARAMETER(_id, _name, _description, _type) \
-    REGISTRY_PARAMETER(_id, _name, _description, _type)
-#endif
-
 #define REGISTRY_PARAMETER_STRING(_id, _name, _description) \
-    _REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_STRING)
+    REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_STRING)
 #define REGISTRY_PARAMETER_BOOL(_id, _name, _description) \
-    _REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_BOOL)
+    REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_BOOL)
 #define REGISTRY_PARAMETER_UINT8(_id, _name, _description) \
-    _REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_UINT8)
+    REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_UINT8)
 #define REGISTRY_PARAMETER_UINT16(_id, _name, _description) \
-    _REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_UINT16)
+    REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_UINT16)
 #define REGISTRY_PARAMETER_UINT32(_id, _name, _description) \
-    _REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_UINT32)
+    REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_UINT32)
 
 #if IS_ACTIVE(CONFIG_REGISTRY_USE_UINT64) || IS_ACTIVE(DOXYGEN)
 # define REGISTRY_PARAMETER_UINT64(_id, _name, _description) \
-    _REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_UINT64)
+    REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_UINT64)
 #else
 # define REGISTRY_PARAMETER_UINT64(_id, _name, _description)
 #endif /* CONFIG_REGISTRY_USE_UINT64 */
 
 #define REGISTRY_PARAMETER_INT8(_id, _name, _description) \
-    _REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_INT8)
+    REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_INT8)
 #define REGISTRY_PARAMETER_INT16(_id, _name, _description) \
-    _REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_INT16)
+    REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_INT16)
 #define REGISTRY_PARAMETER_INT32(_id, _name, _description) \
-    _REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_INT32)
+    REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_INT32)
 
 #if IS_ACTIVE(CONFIG_REGISTRY_USE_INT64) || IS_ACTIVE(DOXYGEN)
 # define REGISTRY_PARAMETER_INT64(_id, _name, _description) \
-    _REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_INT64)
+    REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_INT64)
 #else
 # define REGISTRY_PARAMETER_INT64(_id, _name, _description)
 #endif /* CONFIG_REGISTRY_USE_INT64 */
 
 #if IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT32) || IS_ACTIVE(DOXYGEN)
 # define REGISTRY_PARAMETER_FLOAT32(_id, _name, _description) \
-    _REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_FLOAT32)
+    REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_FLOAT32)
 #else
 # define REGISTRY_PARAMETER_FLOAT32(_id, _name, _description)
 #endif /* CONFIG_REGISTRY_USE_FLOAT32 */
 
 #if IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT64) || IS_ACTIVE(DOXYGEN)
 # define REGISTRY_PARAMETER_FLOAT64(_id, _name, _description) \
-    _REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_FLOAT64)
+    REGISTRY_PARAMETER(_id, _name, _description, REGISTRY_TYPE_FLOAT64)
 #else
 # define REGISTRY_PARAMETER_FLOAT64(_id, _name, _description)
 #endif /* CONFIG_REGISTRY_USE_FLOAT64 */
@@ -238,6 +312,22 @@ typedef struct {
     size_t path_len;
 } registry_path_t;
 
+/**
+ * @brief Largest id that fits into a @ref registry_path_packed_t.
+ */
+#define REGISTRY_PATH_PACKED_ID_MAX UINT16_MAX
+
+/**
+ * @brief Compact form of a @ref registry_path_t, that contains the ids themselves instead of
+ * pointers to them. It can be copied and stored, unused ids are always 0. Compare it with
+ * @ref registry_path_packed_equal(), because the padding of the struct is not defined.
+ * See @ref registry_path_pack() and @ref registry_path_unpack().
+ */
+typedef struct {
+    uint16_t ids[REGISTRY_MAX_DIR_DEPTH + 3];   /**< Namespace, schema and instance id followed by the ids of the schema items */
+    uint8_t ids_len;                            /**< Amount of used ids, 0 is the root of the registry */
+} registry_path_packed_t;
+
 #define _REGISTRY_PATH_NUMARGS(...)  (sizeof((registry_id_t[]){ __VA_ARGS__ }) / \
                                       sizeof(registry_id_t))
 
@@ -321,37 +411,36 @@ typedef struct {
     size_t buf_len;         /**< Length of the buffer */
 } registry_value_t;
 
-/**
- * @brief Parameter of a configuration group.
- */
-typedef struct {
-    registry_type_t type; /**< Enum representing the type of the configuration parameter */
-} registry_schema_parameter_t;
-
 typedef struct _registry_schema_item_t registry_schema_item_t;
 
 /**
- * @brief Configuration group.
+ * @brief Kind of a schema item.
  */
-typedef struct {
-    registry_schema_item_t *items;
-    size_t items_len;
-} registry_schema_group_t;
-
 typedef enum {
     REGISTRY_SCHEMA_TYPE_GROUP,
     REGISTRY_SCHEMA_TYPE_PARAMETER,
 } registry_schema_type_t;
 
+/**
+ * @brief Largest id of a schema item and largest amount of children of a group.
+ */
+#define REGISTRY_SCHEMA_ITEM_ID_MAX UINT16_MAX
+
+/**
+ * @brief Group or parameter of a schema. The item is packed, because big schemas contain
+ * hundreds of them. Use @ref registry_schema_item_name() and
+ * @ref registry_schema_item_description() to read its strings.
+ */
 struct _registry_schema_item_t {
-    registry_id_t id;                           /**< Integer representing the path id of the schema item */
-    char *name;                                 /**< String describing the schema item */
-    char *description;                          /**< String describing the schema item with more details */
-    registry_schema_type_t type;                /**< Type of the schema item (group or parameter) */
-    union {
-        registry_schema_group_t group;          /**< Value of the schema item if it is a group. Contains an array of schema item children */
-        registry_schema_parameter_t parameter;  /**< Value of the schema item if it is a parameter. Contains its type */
-    } value;                                    /**< Union containing either group or parameter data */
+#if !IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD) || \
+    !IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_DESCRIPTION_FIELD) || IS_ACTIVE(DOXYGEN)
+    const char *strings;            /**< Name and description of the schema item, separated by '\0'. Only the enabled ones are stored */
+#endif
+    registry_schema_item_t *items;  /**< Children of the schema item if it is a group, NULL otherwise */
+    uint16_t id;                    /**< Integer representing the path id of the schema item */
+    uint16_t items_len;             /**< Amount of children if the schema item is a group */
+    uint8_t kind : 1;               /**< Kind of the schema item, see @ref registry_schema_type_t */
+    uint8_t value_type : 7;         /**< Type of the value if the schema item is a parameter, see @ref registry_type_t */
 };
 
 /**
@@ -361,15 +450,6 @@ struct _registry_schema_item_t {
 typedef void (*load_cb_t)(const registry_path_t path, const registry_value_t val,
                           const void *cb_arg);
 
-/**
- * @brief Descriptor used to check duplications in storage facilities
- */
-typedef struct {
-    const registry_path_t path; /**< path of the parameter being checked */
-    const registry_value_t val; /**< value of the parameter being checked */
-    bool is_dup;                /**< flag indicating if the parameter is duplicated or not */
-} registry_dup_check_arg_t;
-
 typedef struct _registry_storage_facility_t registry_storage_facility_t;
 
 /**
@@ -379,6 +459,7 @@ typedef struct {
     clist_node_t node;                  /**< linked list node */
     registry_storage_facility_t *itf;   /**< interface for the facility */
     void *data;                         /**< Struct containing all config data for the storage facility */
+    uint8_t priority;                   /**< Priority as a source, the source with the highest priority wins if multiple contain the same parameter */
 } registry_storage_facility_instance_t;
 
 /**
@@ -418,6 +499,19 @@ struct _registry_storage_facility_t {
     int (*save)(const registry_storage_facility_instance_t *instance, const registry_path_t path,
                 const registry_value_t value);
 
+    /**
+     * @brief If implemented, it returns the hash of the value that is currently
+     * stored for a parameter. It is used to skip saving parameters whose stored
+     * value did not change.
+     *
+     * @param[in] instance Storage facility descriptor
+     * @param[in] path Path of the parameter
+     * @param[out] hash Hash of the stored value, see @ref registry_value_hash()
+     * @return 0 on success, -ENOENT if no hash is known for @p path
+     */
+    int (*hash)(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                uint32_t *hash);
+
     /**
      * @brief If implemented, it is used for any tear-down the storage may need
      * after a saving process.
@@ -428,6 +522,92 @@ struct _registry_storage_facility_t {
     int (*save_end)(const registry_storage_facility_instance_t *instance);
 };
 
+/**
+ * @brief Statistics of the last @ref registry_save() call.
+ */
+typedef struct {
+    size_t saved;   /**< Amount of parameters that were written to the storage facility */
+    size_t skipped; /**< Amount of parameters that were skipped, because their stored value was unchanged */
+} registry_save_stats_t;
+
+#if IS_ACTIVE(CONFIG_REGISTRY_STATS) || IS_ACTIVE(DOXYGEN)
+/**
+ * @brief Operations of the registry that are measured by the statistics.
+ */
+typedef enum {
+    REGISTRY_STATS_OP_GET,      /**< Getting a value with the registry_get functions */
+    REGISTRY_STATS_OP_SET,      /**< Setting a value, including the values of @ref registry_load() */
+    REGISTRY_STATS_OP_COMMIT,   /**< @ref registry_commit() including the commit callbacks */
+    REGISTRY_STATS_OP_EXPORT,   /**< @ref registry_export() */
+    REGISTRY_STATS_OP_LOAD,     /**< @ref registry_load() */
+    REGISTRY_STATS_OP_SAVE,     /**< @ref registry_save() */
+    REGISTRY_STATS_OP_NUMOF,    /**< Amount of measured operations */
+} registry_stats_op_t;
+
+/**
+ * @brief Call counter with a log-scaled latency histogram.
+ */
+typedef struct {
+    uint32_t calls;     /**< Amount of calls */
+    uint32_t errors;    /**< Amount of calls that returned an error */
+    /** Latencies of the calls, bucket i counts the latencies below 2^i microseconds */
+    uint32_t histogram[CONFIG_REGISTRY_STATS_HISTOGRAM_BUCKETS];
+} registry_stats_counter_t;
+
+/**
+ * @brief Statistics of a storage facility.
+ */
+typedef struct {
+    const registry_storage_facility_instance_t *instance;   /**< Storage facility, NULL if unused */
+    registry_stats_counter_t load;                          /**< Calls of its load function */
+    registry_stats_counter_t save;                          /**< Calls of its save function */
+} registry_stats_storage_facility_t;
+
+/**
+ * @brief Statistics of the registry since the start or the last @ref registry_stats_reset().
+ */
+typedef struct {
+    registry_stats_counter_t ops[REGISTRY_STATS_OP_NUMOF];  /**< Counters of the operations */
+    uint32_t conversions;   /**< Amount of set values that had to be converted to the parameter type */
+    /** Counters of the storage facilities in the order they were used for the first time */
+    registry_stats_storage_facility_t storage_facilities[CONFIG_REGISTRY_STATS_STORAGE_FACILITIES];
+} registry_stats_t;
+#endif /* CONFIG_REGISTRY_STATS */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_TRACE) || IS_ACTIVE(DOXYGEN)
+/**
+ * @brief Operations of the registry that are recorded by the trace.
+ */
+typedef enum {
+    REGISTRY_TRACE_OP_SET,      /**< Setting a value, including the values of @ref registry_load() */
+    REGISTRY_TRACE_OP_COMMIT,   /**< @ref registry_commit() */
+    REGISTRY_TRACE_OP_LOAD,     /**< @ref registry_load() */
+    REGISTRY_TRACE_OP_SAVE,     /**< @ref registry_save() */
+} registry_trace_op_t;
+
+/**
+ * @brief Trace event of a single registry operation. It is recorded when the operation returns,
+ * so the values set by a @ref registry_load() are recorded before the load itself.
+ */
+typedef struct {
+    uint32_t seq;           /**< Sequence number of the event */
+    uint32_t timestamp;     /**< Time of the event in milliseconds (ZTIMER_MSEC) */
+    /** Ids of the path after the namespace id: schema, instance and schema items */
+    registry_id_t ids[CONFIG_REGISTRY_TRACE_PATH_LEN];
+    int16_t res;            /**< Return value of the operation */
+    int16_t pid;            /**< Id of the thread that called the operation */
+    uint8_t op;             /**< Operation, see @ref registry_trace_op_t */
+    uint8_t namespace_id;   /**< Namespace id of the path, only valid if path_len > 0 */
+    /** Amount of ids of the path including the namespace id, can be bigger than the recorded ids */
+    uint8_t path_len;
+} registry_trace_event_t;
+
+/**
+ * @brief Prototype of a callback function that receives the drained trace events.
+ */
+typedef void (*registry_trace_cb_t)(const registry_trace_event_t *event, void *context);
+#endif /* CONFIG_REGISTRY_TRACE */
+
 /**
  * @brief Instance of a schema containing its data.
  */
@@ -446,6 +626,10 @@ typedef struct {
     int (*commit_cb)(const registry_path_t path, const void *context);
 
     void *context; /**< Optional context used by the instance */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_LAZY_LOAD) || IS_ACTIVE(DOXYGEN)
+    bool loaded;    /**< Internal: true if the values of the instance were loaded from the storage facilities */
+#endif /* CONFIG_REGISTRY_LAZY_LOAD */
 } registry_instance_t;
 
 /**
@@ -475,6 +659,78 @@ typedef struct {
                     size_t *val_len);
 } registry_schema_t;
 
+/**
+ * @brief Caches the schema and instance of the last lookup, so that setting or getting many
+ * parameters of the same instance only resolves the instance once.
+ * It must be zero initialized before its first use and must not be used anymore after
+ * schemas or instances were registered.
+ */
+typedef struct {
+    registry_namespace_id_t namespace_id;   /**< Namespace id of the cached instance */
+    registry_id_t schema_id;                /**< Schema id of the cached instance */
+    registry_id_t instance_id;              /**< Instance id of the cached instance */
+    const registry_schema_t *schema;        /**< Cached schema, only valid if instance is not NULL */
+    const registry_instance_t *instance;    /**< Cached instance, NULL if the cache is empty */
+} registry_lookup_cache_t;
+
+/**
+ * @brief Frame of a @ref registry_iter_t. Each frame walks over the children of one
+ * level of the tree (namespaces, schemas, instances or schema items).
+ */
+typedef struct {
+    const registry_schema_item_t *items;    /**< Schema items of the level, NULL for other levels */
+    clist_node_t *next;                     /**< Next schema or instance node, NULL if none is left */
+    clist_node_t *last;                     /**< Last schema or instance node of the level */
+    size_t index;                           /**< Index of the next namespace id, instance id or schema item */
+    size_t len;                             /**< Index behind the last namespace id or schema item */
+    int recursion_depth;                    /**< Recursion depth of the children of the level */
+} registry_iter_frame_t;
+
+/**
+ * @brief Cursor to enumerate the registry one node at a time, see @ref registry_iter_init().
+ * All of its fields are internal.
+ */
+typedef struct {
+    registry_iter_frame_t frames[3 + REGISTRY_MAX_DIR_DEPTH];   /**< Stack of the levels that are walked */
+    size_t frames_len;                                          /**< Amount of used frames */
+    size_t fixed_len;                                           /**< Amount of namespace, schema and instance ids that are given by the path */
+    size_t path_offset;                                         /**< Amount of ids of path that are not walked, but given by the path */
+    size_t path_len;                                            /**< Amount of schema item ids given by the path */
+    registry_namespace_id_t namespace_id;                       /**< Namespace id of the current node */
+    registry_id_t schema_id;                                    /**< Schema id of the current node */
+    registry_id_t instance_id;                                  /**< Instance id of the current node */
+    registry_id_t path[REGISTRY_MAX_DIR_DEPTH];                 /**< Schema item ids of the current node */
+    const registry_schema_t *schema;                            /**< Schema of the current node */
+    const registry_instance_t *instance;                        /**< Instance of the current node */
+    registry_value_t value;                                     /**< Value of the current node */
+    bool skipped;                                               /**< Children of the current node were skipped, because they are too deep */
+} registry_iter_t;
+
+/**
+ * @brief Continuation token of @ref registry_export_page(), containing the path of the
+ * last exported node. It must be zero initialized before the first page.
+ */
+typedef struct {
+    registry_namespace_id_t namespace_id;   /**< Namespace id of the last exported node */
+    registry_id_t schema_id;                /**< Schema id of the last exported node */
+    registry_id_t instance_id;              /**< Instance id of the last exported node */
+    registry_id_t path[REGISTRY_MAX_DIR_DEPTH]; /**< Schema item ids of the last exported node */
+    uint8_t level;                          /**< Level of the last exported node: 0 = none, 1 = namespace, 2 = schema, 3 = instance, 3 + n = schema item with n ids */
+} registry_export_token_t;
+
+/**
+ * @brief Node of the registry returned by @ref registry_iter_next().
+ * It has the same meaning as the arguments of the export function of @ref registry_export()
+ * and points into the @ref registry_iter_t, so it is only valid until the next call.
+ */
+typedef struct {
+    registry_path_t path;                   /**< Path of the node */
+    const registry_schema_t *schema;        /**< Schema of the node, NULL for namespaces */
+    const registry_instance_t *instance;    /**< Instance of the node, NULL for namespaces and schemas */
+    const registry_schema_item_t *meta;     /**< Schema item of the node, NULL for namespaces, schemas and instances */
+    const registry_value_t *value;          /**< Value of the node, NULL if it is not a parameter */
+} registry_iter_entry_t;
+
 /**
  * @brief Initializes the RIOT Registry.
  */
@@ -485,6 +741,8 @@ void registry_init(void);
  *
  * @param[in] namespace_id ID of the namespace.
  * @param[in] schema Pointer to the schema structure.
+ * @return 0 on success, -EINVAL if the namespace does not exist, -ENOMEM if the schema was
+ * registered, but not all of its names fit into @ref CONFIG_REGISTRY_NAME_INDEX_SIZE
  */
 int registry_register_schema(const registry_namespace_id_t namespace_id,
                              const registry_schema_t *schema);
@@ -492,9 +750,12 @@ int registry_register_schema(const registry_namespace_id_t namespace_id,
 /**
  * @brief Registers a new storage as a source of configurations. Multiple
  *        storages can be configured as sources at the same time. Configurations
- *        will be loaded from all of them. This is commonly called by the
- *        storage facilities who implement their own registry_<storage-name>_src
- *        function.
+ *        will be loaded from all of them. If multiple sources contain the same
+ *        parameter, the value of the source with the highest
+ *        @ref registry_storage_facility_instance_t::priority is used. Sources
+ *        with the same priority are ordered by their registration.
+ *        This is commonly called by the storage facilities who implement their
+ *        own registry_<storage-name>_src function.
  *
  * @param[in] src Pointer to the storage to register as source.
  */
@@ -517,11 +778,63 @@ void registry_register_storage_facility_dst(const registry_storage_facility_inst
  * @param[in] namespace_id ID of the namespace.
  * @param[in] schema_id ID of the schema.
  * @param[in] instance Pointer to instance structure.
+ * @return ID of the instance, -EINVAL if the namespace or schema does not exist, -ENOMEM if the
+ * instance was added, but its name does not fit into @ref CONFIG_REGISTRY_NAME_INDEX_SIZE
  */
 int registry_register_schema_instance(const registry_namespace_id_t namespace_id,
                                       const registry_id_t schema_id,
                                       const registry_instance_t *instance);
 
+/**
+ * @brief Converts a path of names like "sys/rgb/rgb-0/red" to a @ref registry_path_t.
+ * Segments that only consist of digits are used as ids, so names and ids can be mixed.
+ * The names are looked up in an index that is filled when schemas and instances are registered,
+ * see @ref CONFIG_REGISTRY_NAME_INDEX_SIZE.
+ *
+ * @param[in] names Names separated by @ref REGISTRY_NAME_SEPARATOR
+ * @param[out] ids Buffer for the ids of the path, must hold REGISTRY_MAX_DIR_DEPTH + 3 ids
+ * @param[out] path Path pointing to the ids inside of @p ids
+ * @return 0 on success, -ENOENT if a name or id does not exist, -EINVAL if @p names is malformed
+ */
+int registry_path_from_names(const char *names, registry_id_t *ids, registry_path_t *path);
+
+/**
+ * @brief Converts @p path to its packed form.
+ *
+ * @param[in] path Path to convert
+ * @param[out] packed Packed path
+ * @return 0 on success, -EINVAL if an id is bigger than @ref REGISTRY_PATH_PACKED_ID_MAX or
+ * @p path is deeper than @ref REGISTRY_MAX_DIR_DEPTH
+ */
+int registry_path_pack(const registry_path_t path, registry_path_packed_t *packed);
+
+/**
+ * @brief Converts a packed path back to a @ref registry_path_t.
+ *
+ * @param[in] packed Packed path to convert
+ * @param[out] ids Buffer for the ids of the path, must hold REGISTRY_MAX_DIR_DEPTH + 3 ids
+ * @param[out] path Path pointing to the ids inside of @p ids
+ */
+void registry_path_unpack(const registry_path_packed_t *packed, registry_id_t *ids,
+                          registry_path_t *path);
+
+/**
+ * @brief Returns the name of a schema item.
+ *
+ * @param[in] item Schema item
+ * @return Name of @p item, an empty string if CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD is set
+ */
+const char *registry_schema_item_name(const registry_schema_item_t *item);
+
+/**
+ * @brief Returns the description of a schema item.
+ *
+ * @param[in] item Schema item
+ * @return Description of @p item, an empty string if
+ * CONFIG_REGISTRY_DISABLE_SCHEMA_DESCRIPTION_FIELD is set
+ */
+const char *registry_schema_item_description(const registry_schema_item_t *item);
+
 /**
  * @brief Sets the value of a parameter that belongs to a configuration group.
  *
@@ -532,6 +845,60 @@ int registry_register_schema_instance(const registry_namespace_id_t namespace_id
  */
 int registry_set_value(const registry_path_t path, const registry_value_t val);
 
+/**
+ * @brief Same as @ref registry_set_value(), but reuses the schema and instance lookup of
+ * the previous call if @p path points to the same instance.
+ *
+ * @param[in,out] cache Lookup cache that is shared between consecutive calls
+ * @param[in] path Path of the parameter to be set
+ * @param[in] val New value for the parameter
+ * @return 0 on success, -EINVAL if the parameter could not be found or converted
+ */
+int registry_set_value_cached(registry_lookup_cache_t *cache, const registry_path_t path,
+                              const registry_value_t val);
+
+/**
+ * @brief Prototype of a callback that decodes the new value of a parameter for
+ * @ref registry_set_value_decoded().
+ *
+ * @param[in] type Type of the parameter
+ * @param[out] buf Zero initialized buffer of the size of the parameter
+ * @param[in] buf_len Size of the parameter
+ * @param[in] arg Argument that was passed to @ref registry_set_value_decoded()
+ * @return 0 on success, non-zero on failure
+ */
+typedef int (*registry_value_decode_cb_t)(const registry_type_t type, void *buf,
+                                          const size_t buf_len, void *arg);
+
+/**
+ * @brief Sets a parameter to a value that is decoded by @p decode_cb as the type of the
+ * parameter. Other than getting the type first and setting the decoded value afterwards, the
+ * parameter is only looked up once. The parameter is left unchanged if @p decode_cb fails.
+ *
+ * @param[in,out] cache Lookup cache that is shared between consecutive calls
+ * @param[in] path Path of the parameter to be set
+ * @param[in] decode_cb Callback that decodes the new value
+ * @param[in] arg Argument that is passed to @p decode_cb
+ * @return 0 on success, -EINVAL if the parameter could not be found, otherwise the error of
+ *         @p decode_cb
+ */
+int registry_set_value_decoded(registry_lookup_cache_t *cache, const registry_path_t path,
+                               const registry_value_decode_cb_t decode_cb, void *arg);
+
+/**
+ * @brief Parses @p str as the type of the parameter at @p path and sets it.
+ *
+ * Unlike @ref registry_set_string(), the string is parsed directly into the
+ * value of the parameter instead of being converted through an intermediate
+ * value. Opaque parameters are expected as base64 and padded with zeros if
+ * they decode to less bytes than the parameter has.
+ *
+ * @param[in] path Path of the parameter to be set
+ * @param[in] str Null terminated string representation of the new value
+ * @return 0 on success, -EINVAL if the parameter could not be found or @p str could not be parsed
+ */
+int registry_set_from_str(const registry_path_t path, const char *str);
+
 int registry_set_opaque(const registry_path_t path, const void *val, const size_t val_len);
 int registry_set_string(const registry_path_t path, const char *val);
 int registry_set_bool(const registry_path_t path, const bool val);
@@ -563,6 +930,18 @@ int registry_set_float64(const registry_path_t path, const double val);
  */
 int registry_get_value(const registry_path_t path, registry_value_t *value);
 
+/**
+ * @brief Same as @ref registry_get_value(), but reuses the schema and instance lookup of
+ * the previous call if @p path points to the same instance.
+ *
+ * @param[in,out] cache Lookup cache that is shared between consecutive calls
+ * @param[in] path Path of the parameter to get the value of
+ * @param[out] value Pointer to a uninitialized @ref registry_value_t struct
+ * @return 0 on success, non-zero on failure
+ */
+int registry_get_value_cached(registry_lookup_cache_t *cache, const registry_path_t path,
+                              registry_value_t *value);
+
 int registry_get_opaque(const registry_path_t path, const void **buf, size_t *buf_len);
 int registry_get_string(const registry_path_t path, const char **buf, size_t *buf_len);
 int registry_get_bool(const registry_path_t path, const bool **buf);
@@ -599,22 +978,101 @@ int registry_commit(const registry_path_t path);
 
 /**
  * @brief Load all configuration parameters that are included in the path from the registered storage
- * facility.
+ * facilities. Every parameter is only set once, using the source with the highest priority that
+ * contains it.
  *
  * @param[in] path Path of the configuration parameters
- * @return 0 on success, non-zero on failure
+ * @return 0 on success, -ENOBUFS if more parameters were loaded than
+ * @ref CONFIG_REGISTRY_LOAD_INDEX_SIZE allows to track. The sources with a lower priority are
+ * not loaded then, because they would overwrite the untracked parameters. Other non-zero
+ * values on failure
  */
 int registry_load(const registry_path_t path);
 
+/**
+ * @brief Gets the type and the current value of a parameter while it is loaded. Storage facilities
+ * call this from their load function, if they need to know the type or size of a stored value
+ * before they can read it. The lookup is shared with applying the loaded values, so it is
+ * cheaper than @ref registry_get_value(). It never loads an instance lazily, so the storage
+ * facilities are not re-entered.
+ *
+ * @param[in] path Path of the parameter
+ * @param[out] value Type, buffer and buffer length of the parameter
+ * @return 0 on success, -EINVAL if the parameter could not be found
+ */
+int registry_load_expected_value(const registry_path_t path, registry_value_t *value);
+
 /**
  * @brief Save all configuration parameters of every configuration group to the
- * registered storage facility.
+ * registered storage facility. If a parameter can not be saved, the remaining ones are still
+ * saved and the first error of the storage facility is returned.
  *
  * @param[in] path Path of the configuration parameters
  * @return 0 on success, non-zero on failure
  */
 int registry_save(const registry_path_t path);
 
+/**
+ * @brief Gets the statistics of the last @ref registry_save() call.
+ *
+ * @param[out] stats Pointer to the struct that will be filled with the statistics
+ */
+void registry_get_save_stats(registry_save_stats_t *stats);
+
+#if IS_ACTIVE(CONFIG_REGISTRY_STATS) || IS_ACTIVE(DOXYGEN)
+/**
+ * @brief Gets the statistics of all registry operations. Only available if
+ * @ref CONFIG_REGISTRY_STATS is enabled.
+ *
+ * Each counter is updated atomically, but calls that run concurrently to this one may
+ * already be counted in some counters and not yet in others.
+ *
+ * @param[out] stats Pointer to the struct that will be filled with the statistics
+ */
+void registry_stats_get(registry_stats_t *stats);
+
+/**
+ * @brief Resets the statistics of all registry operations. Calls that run concurrently to
+ * this one may be counted partially.
+ */
+void registry_stats_reset(void);
+#endif /* CONFIG_REGISTRY_STATS */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_TRACE) || IS_ACTIVE(DOXYGEN)
+/**
+ * @brief Passes all trace events that were recorded since the last call to @p cb, oldest first.
+ * Only available if @ref CONFIG_REGISTRY_TRACE is enabled.
+ *
+ * Recording does not lock, so events can be recorded while draining. Events that are still
+ * being recorded are passed with the next call. Only one thread may drain at a time.
+ *
+ * @param[in] cb Callback function that is called for every event
+ * @param[in] context Context that is passed to @p cb
+ * @return Amount of events that were overwritten before they could be drained
+ */
+size_t registry_trace_drain(registry_trace_cb_t cb, void *context);
+#endif /* CONFIG_REGISTRY_TRACE */
+
+/**
+ * @brief Calculates the CRC32 hash of the buffer of a value. Storage facilities
+ * use it to implement the hash function of their interface.
+ *
+ * @param[in] value Value to calculate the hash of
+ * @return CRC32 hash of the buffer of @p value
+ */
+uint32_t registry_value_hash(const registry_value_t *value);
+
+/**
+ * @brief Calculates the CRC32 of @p buf. Data that is processed in chunks can be
+ * hashed by starting with a @p crc of 0 and passing the result of the previous chunk.
+ *
+ * @param[in] crc CRC32 of the previous chunks or 0
+ * @param[in] buf Buffer containing the next chunk
+ * @param[in] len Length of @p buf
+ * @return CRC32 of all chunks including @p buf
+ */
+uint32_t registry_crc32(const uint32_t crc, const void *buf, const size_t len);
+
 /**
  * @brief Export an specific or all configuration parameters using the
  * @p export_func function. If @p path is NULL then @p export_func is called for
@@ -635,6 +1093,64 @@ int registry_export(int (*export_func)(const registry_path_t path,
                                        const void *context),
                     const registry_path_t path, const int recursion_depth, const void *context);
 
+/**
+ * @brief Same as @ref registry_export(), but exports at most @p max_entries nodes per call.
+ * The next call with the same @p path, @p recursion_depth and @p token continues behind the
+ * last exported node, without walking the nodes before it again. Other registry functions
+ * can be called between two pages.
+ * If @p export_func returns non-zero, the page ends before that node, so that it is exported
+ * again by the next call. This allows to limit pages by their size in bytes.
+ *
+ * @param[in] export_func Exporting function, see @ref registry_export()
+ * @param[in] path Path representing the configuration parameter. Can be NULL.
+ * @param[in] recursion_depth Defines how deeply nested child groups / parameters will be shown, see @ref registry_export()
+ * @param[in,out] token Continuation token, zero initialized for the first page
+ * @param[in] max_entries Maximum amount of nodes to export, must not be 0
+ * @param[in] context Context that will be passed to @p export_func
+ * @return 1 if there are more nodes left, 0 if the export is complete,
+ * -ENOBUFS if @p export_func rejected the first node of the page,
+ * -EINVAL if @p max_entries is 0, @p token does not belong to @p path or a node of @p path
+ * does not exist
+ */
+int registry_export_page(int (*export_func)(const registry_path_t path,
+                                            const registry_schema_t *schema,
+                                            const registry_instance_t *instance,
+                                            const registry_schema_item_t *meta,
+                                            const registry_value_t *value,
+                                            const void *context),
+                         const registry_path_t path, const int recursion_depth,
+                         registry_export_token_t *token, const size_t max_entries,
+                         const void *context);
+
+/**
+ * @brief Initializes a cursor that enumerates the same nodes in the same order as
+ * @ref registry_export(), but one node at a time per @ref registry_iter_next() call.
+ * The ids of @p path are copied, so it does not have to outlive @p iter.
+ * Schemas and instances must not be registered while the cursor is used.
+ *
+ * @param[out] iter Cursor to initialize
+ * @param[in] path Path representing the configuration parameter. Can be NULL.
+ * @param[in] recursion_depth Defines how deeply nested child groups / parameters will be returned, see @ref registry_export()
+ * @return 0 on success, -EINVAL if @p path is deeper than @ref REGISTRY_MAX_DIR_DEPTH
+ */
+int registry_iter_init(registry_iter_t *iter, const registry_path_t path,
+                       const int recursion_depth);
+
+/**
+ * @brief Advances the cursor to the next node. Every call does a constant amount of work,
+ * except for looking up the nodes that are given by the path of @ref registry_iter_init().
+ * Children of groups that are nested deeper than @ref REGISTRY_MAX_DIR_DEPTH are skipped.
+ * The group itself is still returned, and the call after it returns -EINVAL before the cursor
+ * continues with the next node.
+ *
+ * @param[in] iter Cursor initialized by @ref registry_iter_init()
+ * @param[out] entry Next node
+ * @return 0 if @p entry contains the next node, -ENOENT if all nodes were returned,
+ * -EINVAL if a namespace, schema, instance or schema item of the path does not exist or the
+ * children of the previous node were skipped
+ */
+int registry_iter_next(registry_iter_t *iter, registry_iter_entry_t *entry);
+
 #ifdef __cplusplus
 }
 #endif
@@ -73,7 +73,7 @@ int registry_convert_str_to_bytes(const char *src, void *dest, size_t *len);
  * @param[in] src Pointer to the value to be converted
  * @param[out] dest Buffer to store the output string
  * @param[in] dest_len Length of @p buf
- * @return Pointer to the output string
+ * @return Pointer to the output string, NULL if it does not fit into @p dest
  */
 char *registry_convert_value_to_str(const registry_value_t *src, char *dest,
                                     const size_t dest_len);
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2023 HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_registry RIOT Registry
+ * @ingroup     sys
+ * @brief       RIOT Registry module for handling runtime configurations
+ * @{
+ *
+ * @file
+ *
+ * @author      Lasse Rosenow <lasse.rosenow@haw-hamburg.de>
+ */
+
+#ifndef REGISTRY_REGISTRY_PATH_H
+#define REGISTRY_REGISTRY_PATH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "registry.h"
+
+/**
+ * @brief Checks if two paths point to the same node. The ids are compared by value, so the
+ * paths may point to different buffers.
+ *
+ * @param[in] a First path
+ * @param[in] b Second path
+ * @return true if both paths have the same depth and the same ids, false otherwise
+ */
+bool registry_path_equal(const registry_path_t a, const registry_path_t b);
+
+/**
+ * @brief Checks if @p path is located inside of @p prefix (e.g. 0/1 contains 0/1/0/2).
+ * Every path contains itself and the root path contains every path.
+ *
+ * @param[in] prefix Path of the parent node
+ * @param[in] path Path to check
+ * @return true if the ids of @p prefix are the first ids of @p path, false otherwise
+ */
+bool registry_path_is_prefix(const registry_path_t prefix, const registry_path_t path);
+
+/**
+ * @brief Orders two paths by their ids, level by level. A parent is ordered before its children,
+ * so sorting paths results in the same order as a depth-first walk sorted by ids.
+ *
+ * @param[in] a First path
+ * @param[in] b Second path
+ * @return negative if @p a is ordered before @p b, positive if after and 0 if they are equal
+ */
+int registry_path_cmp(const registry_path_t a, const registry_path_t b);
+
+/**
+ * @brief Calculates the CRC32 of the ids of @p path, as if they were a consecutive array of
+ * @ref registry_id_t. Equal paths always have the same hash.
+ *
+ * @param[in] path Path to hash
+ * @return Hash of the path
+ */
+uint32_t registry_path_hash(const registry_path_t path);
+
+/**
+ * @brief Checks if two packed paths point to the same node. Only the used ids are compared, so
+ * the unused ids and the padding of the structs do not matter.
+ *
+ * @param[in] a First packed path
+ * @param[in] b Second packed path
+ * @return true if both paths have the same depth and the same ids, false otherwise
+ */
+bool registry_path_packed_equal(const registry_path_packed_t *a, const registry_path_packed_t *b);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif /* REGISTRY_REGISTRY_PATH_H */
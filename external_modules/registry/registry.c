@@ -29,6 +29,20 @@
 
 #include "registry.h"
 #include "registry_conversion.h"
+#include "registry_path.h"
+
+#if IS_ACTIVE(CONFIG_REGISTRY_STATS) || IS_ACTIVE(CONFIG_REGISTRY_TRACE)
+#include "atomic_utils.h"
+#include "ztimer.h"
+#endif /* CONFIG_REGISTRY_STATS || CONFIG_REGISTRY_TRACE */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_STATS)
+#include "irq.h"
+#endif /* CONFIG_REGISTRY_STATS */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_TRACE)
+#include "thread.h"
+#endif /* CONFIG_REGISTRY_TRACE */
 
 registry_namespace_t registry_namespace_sys = {
     .id = REGISTRY_ROOT_GROUP_SYS,
@@ -46,6 +60,164 @@ registry_namespace_t registry_namespace_app = {
 
 static const registry_storage_facility_instance_t *storage_facility_dst;
 static clist_node_t storage_facility_srcs;
+static registry_save_stats_t save_stats;
+static int save_res;    /* first error of a storage facility during the current registry_save */
+
+/* value buffers of all parameters that were already loaded by registry_load (NULL = empty).
+   Every parameter has its own buffer inside of its instance, so the buffer identifies it exactly */
+static const void *load_index[CONFIG_REGISTRY_LOAD_INDEX_SIZE];
+
+/* lookup of the instance the last loaded parameter belonged to, storage facilities return the
+   parameters of an instance consecutively, so most of them do not need a new lookup */
+static registry_lookup_cache_t load_cache;
+
+static_assert((CONFIG_REGISTRY_LOAD_INDEX_SIZE & (CONFIG_REGISTRY_LOAD_INDEX_SIZE - 1)) == 0,
+              "CONFIG_REGISTRY_LOAD_INDEX_SIZE must be a power of two");
+
+#if IS_ACTIVE(CONFIG_REGISTRY_LAZY_LOAD)
+/* true while registry_load is running, so that setting the loaded values does not trigger lazy loads */
+static bool loading;
+#endif /* CONFIG_REGISTRY_LAZY_LOAD */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_STATS)
+/* the latencies are 32 bit, so bucket 32 already counts everything above UINT32_MAX */
+static_assert(CONFIG_REGISTRY_STATS_HISTOGRAM_BUCKETS >= 1 &&
+              CONFIG_REGISTRY_STATS_HISTOGRAM_BUCKETS <= 33,
+              "CONFIG_REGISTRY_STATS_HISTOGRAM_BUCKETS must be between 1 and 33");
+
+/* the counters are updated atomically, because registry functions are called from any thread */
+static registry_stats_t registry_stats;
+
+/* measures the latency of the code between the two macros and counts it in the counter */
+#define _REGISTRY_STATS_START() const uint32_t _stats_start = ztimer_now(ZTIMER_USEC)
+#define _REGISTRY_STATS_RECORD(counter, res) _registry_stats_record(counter, _stats_start, res)
+
+static void _registry_stats_record(registry_stats_counter_t *counter, const uint32_t start,
+                                   const int res)
+{
+    if (counter == NULL) {
+        return;
+    }
+
+    const uint32_t latency = ztimer_now(ZTIMER_USEC) - start;
+    size_t bucket = 0;
+
+    while (bucket + 1 < CONFIG_REGISTRY_STATS_HISTOGRAM_BUCKETS && latency >= (1ULL << bucket)) {
+        bucket++;
+    }
+
+    atomic_fetch_add_u32(&counter->calls, 1);
+    atomic_fetch_add_u32(&counter->histogram[bucket], 1);
+
+    if (res != 0) {
+        atomic_fetch_add_u32(&counter->errors, 1);
+    }
+}
+
+/* Returns the counter of the storage facility, NULL if all slots are used by other ones */
+static registry_stats_counter_t *_registry_stats_storage_facility(
+    const registry_storage_facility_instance_t *instance, const bool save)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(registry_stats.storage_facilities); i++) {
+        registry_stats_storage_facility_t *storage_facility = &registry_stats.storage_facilities[i];
+
+        if (storage_facility->instance == NULL) {
+            /* two threads must not claim the same slot for different storage facilities */
+            unsigned state = irq_disable();
+
+            if (storage_facility->instance == NULL) {
+                storage_facility->instance = instance;
+            }
+
+            irq_restore(state);
+        }
+
+        if (storage_facility->instance == instance) {
+            return save ? &storage_facility->save : &storage_facility->load;
+        }
+    }
+
+    return NULL;
+}
+#else /* CONFIG_REGISTRY_STATS */
+#define _REGISTRY_STATS_START()
+#define _REGISTRY_STATS_RECORD(counter, res)
+#endif /* CONFIG_REGISTRY_STATS */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_TRACE)
+#define _TRACE_MASK (CONFIG_REGISTRY_TRACE_SIZE - 1)
+
+static_assert((CONFIG_REGISTRY_TRACE_SIZE & _TRACE_MASK) == 0,
+              "CONFIG_REGISTRY_TRACE_SIZE must be a power of two");
+
+static registry_trace_event_t trace_buffer[CONFIG_REGISTRY_TRACE_SIZE];
+/* sequence number of the next event that is recorded or drained */
+static uint32_t trace_head;
+static uint32_t trace_tail;
+
+#define _REGISTRY_TRACE(op, path, res) _registry_trace(op, path, res)
+
+/* Records an event without locking. The sequence number + 1 is written last to mark the event
+   complete, so that the zero initialized buffer does not contain complete events */
+static void _registry_trace(const registry_trace_op_t op, const registry_path_t path,
+                            const int res)
+{
+    const uint32_t seq = atomic_fetch_add_u32(&trace_head, 1);
+    registry_trace_event_t *event = &trace_buffer[seq & _TRACE_MASK];
+    size_t path_len = 0;
+
+    event->timestamp = ztimer_now(ZTIMER_MSEC);
+    event->res = res;
+    event->pid = thread_getpid();
+    event->op = op;
+
+    if (path.namespace_id != NULL) {
+        event->namespace_id = *path.namespace_id;
+        path_len++;
+
+        if (path.schema_id != NULL) {
+            event->ids[0] = *path.schema_id;
+            path_len++;
+
+            if (path.instance_id != NULL) {
+                event->ids[1] = *path.instance_id;
+                path_len++;
+
+                for (size_t i = 0; i < path.path_len && i + 2 < CONFIG_REGISTRY_TRACE_PATH_LEN;
+                     i++) {
+                    event->ids[i + 2] = path.path[i];
+                }
+                path_len += path.path_len;
+            }
+        }
+    }
+
+    event->path_len = path_len;
+
+    atomic_store_u32(&event->seq, seq + 1);
+}
+#else /* CONFIG_REGISTRY_TRACE */
+#define _REGISTRY_TRACE(op, path, res)
+#endif /* CONFIG_REGISTRY_TRACE */
+
+/* maps the name of a schema, instance or schema item to its id */
+typedef struct {
+    const void *parent;     /* namespace, instances of a schema or schema items of the same level */
+    const void *node;       /* schema, instance or schema item */
+    const char *name;       /* name of the node, NULL if the slot is empty */
+    registry_id_t id;       /* id of the node */
+} _registry_name_index_entry_t;
+
+static _registry_name_index_entry_t name_index[CONFIG_REGISTRY_NAME_INDEX_SIZE];
+
+static_assert((CONFIG_REGISTRY_NAME_INDEX_SIZE & (CONFIG_REGISTRY_NAME_INDEX_SIZE - 1)) == 0,
+              "CONFIG_REGISTRY_NAME_INDEX_SIZE must be a power of two");
+
+typedef struct {
+    bool skip_loaded;   /* skip parameters that were already loaded by a source with higher priority */
+    bool track_loaded;  /* add loaded parameters to the load_index, because more sources follow */
+    int res;            /* error that occurred inside of the load callback */
+} _registry_load_arg_t;
 
 static void _debug_print_path(const registry_path_t path)
 {
@@ -175,9 +347,99 @@ static registry_instance_t *_instance_lookup(const registry_schema_t *schema, co
     return NULL;
 }
 
+static uint32_t _registry_name_hash(const void *parent, const char *name, const size_t name_len)
+{
+    /* FNV-1a seeded with the parent, so that equal names of different parents use different slots */
+    uint32_t hash = 2166136261u ^ (uint32_t)(uintptr_t)parent;
+
+    for (size_t i = 0; i < name_len; i++) {
+        hash ^= (uint8_t)name[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/* Returns the slot of the name_index that either contains the name or is empty, NULL if full */
+static _registry_name_index_entry_t *_registry_name_index_lookup(const void *parent,
+                                                                 const char *name,
+                                                                 const size_t name_len)
+{
+    size_t mask = ARRAY_SIZE(name_index) - 1;
+    size_t start = _registry_name_hash(parent, name, name_len) & mask;
+    size_t i = start;
+
+    do {
+        _registry_name_index_entry_t *entry = &name_index[i];
+
+        if (entry->name == NULL ||
+            (entry->parent == parent && strncmp(entry->name, name, name_len) == 0 &&
+             entry->name[name_len] == '\0')) {
+            return entry;
+        }
+
+        i = (i + 1) & mask;
+    } while (i != start);
+
+    return NULL;
+}
+
+static int _registry_name_index_add(const void *parent, const void *node, const char *name,
+                                    const registry_id_t id)
+{
+    /* names can be disabled by CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD */
+    if (name == NULL || name[0] == '\0') {
+        return 0;
+    }
+
+    _registry_name_index_entry_t *entry = _registry_name_index_lookup(parent, name, strlen(name));
+
+    if (entry == NULL) {
+        DEBUG("[registry] name index is full, %s can not be resolved\n", name);
+        return -ENOMEM;
+    }
+
+    *entry = (_registry_name_index_entry_t) {
+        .parent = parent,
+        .node = node,
+        .name = name,
+        .id = id,
+    };
+
+    return 0;
+}
+
+/* Adds all names, even if one of them does not fit, and returns the first error */
+static int _registry_name_index_add_items(const registry_schema_item_t *items,
+                                          const size_t items_len)
+{
+    int res = 0;
+
+    for (size_t i = 0; i < items_len; i++) {
+        int item_res = _registry_name_index_add(items, &items[i],
+                                                registry_schema_item_name(&items[i]),
+                                                items[i].id);
+
+        if (res == 0) {
+            res = item_res;
+        }
+
+        if (items[i].kind == REGISTRY_SCHEMA_TYPE_GROUP) {
+            item_res = _registry_name_index_add_items(items[i].items, items[i].items_len);
+
+            if (res == 0) {
+                res = item_res;
+            }
+        }
+    }
+
+    return res;
+}
+
 void registry_init(void)
 {
     storage_facility_srcs.next = NULL;
+    load_cache.instance = NULL;
 }
 
 int registry_register_schema(const registry_namespace_id_t namespace_id,
@@ -194,7 +456,11 @@ int registry_register_schema(const registry_namespace_id_t namespace_id,
 
     clist_rpush((clist_node_t *)&namespace->schemas, (clist_node_t *)&(schema->node));
 
-    return 0;
+    /* schemas and instances are never removed, so the names can be indexed once */
+    int res = _registry_name_index_add(namespace, schema, schema->name, schema->id);
+    int items_res = _registry_name_index_add_items(schema->items, schema->items_len);
+
+    return res != 0 ? res : items_res;
 }
 
 static registry_schema_item_t *_parameter_meta_lookup(const registry_path_t path,
@@ -209,15 +475,15 @@ static registry_schema_item_t *_parameter_meta_lookup(const registry_path_t path
             schema_item = &schema_items[i];
 
             if (schema_item->id == path.path[path_index]) {
-                if (schema_item->type == REGISTRY_SCHEMA_TYPE_PARAMETER &&
+                if (schema_item->kind == REGISTRY_SCHEMA_TYPE_PARAMETER &&
                     path_index == path.path_len - 1) {
                     /* if this is the last path segment and it is a parameter => return the parameter */
                     return schema_item;
                 }
-                else if (schema_item->type == REGISTRY_SCHEMA_TYPE_GROUP) {
+                else if (schema_item->kind == REGISTRY_SCHEMA_TYPE_GROUP) {
                     /* if this is not the last path segment and its a group => update schemas and schemas_len values */
-                    schema_items = schema_item->value.group.items;
-                    schema_items_len = schema_item->value.group.items_len;
+                    schema_items = schema_item->items;
+                    schema_items_len = schema_item->items_len;
                     break;
                 }
             }
@@ -253,164 +519,615 @@ int registry_register_schema_instance(const registry_namespace_id_t namespace_id
             clist_rpush((clist_node_t *)&(schema->instances), (clist_node_t *)&instance->node);
 
             /* count instance index */
-            return clist_count(&schema->instances) - 1;
+            int instance_id = clist_count(&schema->instances) - 1;
+
+            int res = _registry_name_index_add(&schema->instances, instance, instance->name,
+                                               instance_id);
+
+            return res != 0 ? res : instance_id;
         }
     } while (node != namespace->schemas.next);
 
     return -EINVAL;
 }
 
-static int _registry_set(const registry_path_t path, const void *val, const int val_len,
-                         const registry_type_t val_type)
+static bool _registry_is_id(const char *segment, const size_t segment_len)
 {
-    /* lookup namespace */
-    registry_namespace_t *namespace = _namespace_lookup(*path.namespace_id);
-
-    if (!namespace) {
-        return -EINVAL;
+    for (size_t i = 0; i < segment_len; i++) {
+        if (segment[i] < '0' || segment[i] > '9') {
+            return false;
+        }
     }
 
-    /* lookup schema */
-    registry_schema_t *schema = _schema_lookup(namespace, *path.schema_id);
-
-    if (!schema) {
-        return -EINVAL;
-    }
+    return true;
+}
 
-    /* lookup instance */
-    registry_instance_t *instance = _instance_lookup(schema, *path.instance_id);
+/* Points the levels of path to the consecutive ids of namespace, schema, instance and items */
+static void _registry_path_from_ids(registry_id_t *ids, const size_t ids_len,
+                                    registry_path_t *path)
+{
+    *path = _REGISTRY_PATH_0();
 
-    if (!instance) {
-        return -EINVAL;
+    if (ids_len > 0) {
+        path->namespace_id = (registry_namespace_id_t *)&ids[0];
     }
 
-    /* lookup parameter meta data */
-    registry_schema_item_t *param_meta = _parameter_meta_lookup(path, schema);
+    if (ids_len > 1) {
+        path->schema_id = &ids[1];
+    }
 
-    if (!param_meta) {
-        return -EINVAL;
+    if (ids_len > 2) {
+        path->instance_id = &ids[2];
     }
 
-    /* get pointer to registry internal value buffer and length */
-    size_t intern_val_len;
-    void *intern_val = NULL;
+    if (ids_len > 3) {
+        path->path = &ids[3];
+        path->path_len = ids_len - 3;
+    }
+}
 
-    schema->mapping(param_meta->id, instance, &intern_val, &intern_val_len);
+int registry_path_from_names(const char *names, registry_id_t *ids, registry_path_t *path)
+{
+    assert(names != NULL);
+    assert(ids != NULL);
+    assert(path != NULL);
+
+    const registry_namespace_t *namespace = NULL;
+    const registry_schema_t *schema = NULL;
+    const registry_schema_item_t *items = NULL;
+    size_t items_len = 0;
+    size_t ids_len = 0;
+    const char *segment = names;
+
+    while (*segment != '\0') {
+        const char *separator = strchr(segment, REGISTRY_NAME_SEPARATOR);
+        const size_t segment_len = separator ? (size_t)(separator - segment) : strlen(segment);
+        const void *node = NULL;
+        registry_id_t id = 0;
+
+        if (segment_len == 0 || ids_len >= REGISTRY_MAX_DIR_DEPTH + 3) {
+            return -EINVAL;
+        }
 
-    /* check if val_type is compatible with param_meta->value.parameter.type */
-    if (val_type != param_meta->value.parameter.type) {
-        uint8_t new_val[intern_val_len];
-        registry_value_t old_val = {
-            .type = val_type,
-            .buf = val,
-            .buf_len = val_len,
-        };
-        int conversion_error_code = registry_convert_value_to_value(&old_val, new_val,
-                                                                    intern_val_len,
-                                                                    param_meta->value.parameter.type);
-        if (conversion_error_code == 0) {
-            /* call handler to apply the new value to the correct parameter in the instance of the schema */
-            memcpy(intern_val, new_val, intern_val_len);
+        if (_registry_is_id(segment, segment_len)) {
+            for (size_t i = 0; i < segment_len; i++) {
+                id = id * 10 + (segment[i] - '0');
+            }
+        }
+        else if (ids_len == 0) {
+            /* there are only two namespaces, so they are not indexed */
+            if (strncmp(registry_namespace_sys.name, segment, segment_len) == 0 &&
+                registry_namespace_sys.name[segment_len] == '\0') {
+                id = REGISTRY_ROOT_GROUP_SYS;
+            }
+            else if (strncmp(registry_namespace_app.name, segment, segment_len) == 0 &&
+                     registry_namespace_app.name[segment_len] == '\0') {
+                id = REGISTRY_ROOT_GROUP_APP;
+            }
+            else {
+                return -ENOENT;
+            }
         }
         else {
-            return conversion_error_code;
+            /* the parent of the names of the current level */
+            const void *parent = ids_len == 1 ? (const void *)namespace :
+                                 ids_len == 2 ? (const void *)&schema->instances :
+                                 (const void *)items;
+            const _registry_name_index_entry_t *entry =
+                _registry_name_index_lookup(parent, segment, segment_len);
+
+            if (entry == NULL || entry->name == NULL) {
+                return -ENOENT;
+            }
+
+            id = entry->id;
+            node = entry->node;
         }
+
+        /* resolve the node, because it is the parent of the names of the next level */
+        if (ids_len == 0) {
+            namespace = _namespace_lookup(id);
+
+            if (!namespace) {
+                return -ENOENT;
+            }
+        }
+        else if (ids_len == 1) {
+            schema = node ? node : _schema_lookup(namespace, id);
+
+            if (!schema) {
+                return -ENOENT;
+            }
+
+            items = schema->items;
+            items_len = schema->items_len;
+        }
+        else if (ids_len > 2) {
+            const registry_schema_item_t *item = node;
+
+            for (size_t i = 0; item == NULL && i < items_len; i++) {
+                if (items[i].id == id) {
+                    item = &items[i];
+                }
+            }
+
+            if (!item) {
+                return -ENOENT;
+            }
+
+            if (item->kind == REGISTRY_SCHEMA_TYPE_GROUP) {
+                items = item->items;
+                items_len = item->items_len;
+            }
+            else {
+                items = NULL;
+                items_len = 0;
+            }
+        }
+
+        ids[ids_len++] = id;
+        segment += separator ? segment_len + 1 : segment_len;
     }
-    else {
-        /* call handler to apply the new value to the correct parameter in the instance of the schema */
-        memcpy(intern_val, val, intern_val_len);
-    }
+
+    _registry_path_from_ids(ids, ids_len, path);
 
     return 0;
 }
 
-static int _registry_get(const registry_path_t path, const registry_type_t requested_val_type,
-                         registry_value_t *val_buf)
+int registry_path_pack(const registry_path_t path, registry_path_packed_t *packed)
 {
-    /* lookup namespace */
-    registry_namespace_t *namespace = _namespace_lookup(*path.namespace_id);
+    assert(packed != NULL);
 
-    if (!namespace) {
-        return -EINVAL;
+    memset(packed, 0, sizeof(*packed));
+
+    if (path.namespace_id == NULL) {
+        return 0;
     }
 
-    /* lookup schema */
-    registry_schema_t *schema = _schema_lookup(namespace, *path.schema_id);
+    packed->ids[packed->ids_len++] = *path.namespace_id;
 
-    if (!schema) {
-        return -EINVAL;
+    if (path.schema_id == NULL) {
+        return 0;
     }
 
-    /* lookup instance */
-    registry_instance_t *instance = _instance_lookup(schema, *path.instance_id);
-
-    if (!instance) {
+    if (*path.schema_id > REGISTRY_PATH_PACKED_ID_MAX) {
         return -EINVAL;
     }
 
-    /* lookup parameter meta data */
-    registry_schema_item_t *param_meta = _parameter_meta_lookup(path, schema);
+    packed->ids[packed->ids_len++] = *path.schema_id;
 
-    if (!param_meta) {
-        return -EINVAL;
+    if (path.instance_id == NULL) {
+        return 0;
     }
 
-    /* if no specific type was requested, set the registry_value_t type to the type of the schema param */
-    if (requested_val_type == REGISTRY_TYPE_NONE) {
-        val_buf->type = param_meta->value.parameter.type;
-    }
-    /* check if the requested val_type is compatible with the actual type of the parameter */
-    else if (requested_val_type != param_meta->value.parameter.type) {
+    if (*path.instance_id > REGISTRY_PATH_PACKED_ID_MAX ||
+        path.path_len > REGISTRY_MAX_DIR_DEPTH) {
         return -EINVAL;
     }
 
-    /* call handler to get the parameter value from the instance of the schema */
-    void *buf = NULL;
-    size_t buf_len;
+    packed->ids[packed->ids_len++] = *path.instance_id;
 
-    schema->mapping(param_meta->id, instance, &buf, &buf_len);
+    for (size_t i = 0; i < path.path_len; i++) {
+        if (path.path[i] > REGISTRY_PATH_PACKED_ID_MAX) {
+            return -EINVAL;
+        }
 
-    /* update buf pointer in registry_value_t to point to the value inside the registry and set buf_len */
-    val_buf->buf = buf;
-    val_buf->buf_len = buf_len;
+        packed->ids[packed->ids_len++] = path.path[i];
+    }
 
     return 0;
 }
 
-static int _registry_commit_schema(const registry_path_t path)
+void registry_path_unpack(const registry_path_packed_t *packed, registry_id_t *ids,
+                          registry_path_t *path)
 {
-    int rc = 0;
-
-    /* lookup namespace */
-    registry_namespace_t *namespace = _namespace_lookup(*path.namespace_id);
+    assert(packed != NULL);
+    assert(ids != NULL);
+    assert(path != NULL);
 
-    if (!namespace) {
-        return -EINVAL;
+    for (size_t i = 0; i < packed->ids_len; i++) {
+        ids[i] = packed->ids[i];
     }
 
-    /* lookup schema */
-    registry_schema_t *schema = _schema_lookup(namespace, *path.schema_id);
+    _registry_path_from_ids(ids, packed->ids_len, path);
+}
 
-    if (!schema) {
-        return -EINVAL;
+const char *registry_schema_item_name(const registry_schema_item_t *item)
+{
+    assert(item != NULL);
+
+#if IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD)
+    (void)item;
+    return "";
+#else
+    return item->strings;
+#endif
+}
+
+const char *registry_schema_item_description(const registry_schema_item_t *item)
+{
+    assert(item != NULL);
+
+#if IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_DESCRIPTION_FIELD)
+    (void)item;
+    return "";
+#elif IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD)
+    return item->strings;
+#else
+    /* the description follows the terminating '\0' of the name */
+    return item->strings + strlen(item->strings) + 1;
+#endif
+}
+
+#if IS_ACTIVE(CONFIG_REGISTRY_LAZY_LOAD)
+static void _registry_lazy_load_instance(const registry_namespace_id_t namespace_id,
+                                         const registry_id_t schema_id,
+                                         const registry_id_t instance_id,
+                                         registry_instance_t *instance)
+{
+    if (instance->loaded || loading) {
+        return;
     }
 
-    /* schema/instance */
-    if (path.instance_id != NULL) {
-        /* lookup instance */
-        registry_instance_t *instance = _instance_lookup(schema, *path.instance_id);
-        if (!instance) {
-            return -EINVAL;
+    registry_namespace_id_t _namespace_id = namespace_id;
+    registry_id_t _schema_id = schema_id;
+    registry_id_t _instance_id = instance_id;
+    registry_path_t path = {
+        .namespace_id = &_namespace_id,
+        .schema_id = &_schema_id,
+        .instance_id = &_instance_id,
+        .path = NULL,
+        .path_len = 0,
+    };
+
+    /* registry_load marks the instance as loaded */
+    registry_load(path);
+}
+
+/* Loads all instances included in the path that were not loaded yet, or only marks them as loaded */
+static void _registry_lazy_load_path(const registry_path_t path, const bool mark_only)
+{
+    for (registry_namespace_id_t namespace_id = REGISTRY_ROOT_GROUP_SYS;
+         namespace_id <= REGISTRY_ROOT_GROUP_APP; namespace_id++) {
+        registry_namespace_t *namespace = _namespace_lookup(namespace_id);
+
+        if ((path.namespace_id != NULL && *path.namespace_id != namespace_id) ||
+            namespace->schemas.next == NULL) {
+            continue;
         }
-        if (instance->commit_cb) {
-            registry_path_t new_path = REGISTRY_PATH(*path.namespace_id, *path.schema_id,
-                                                     *path.instance_id);
-            int _rc = instance->commit_cb(new_path, instance->context);
-            if (!_rc) {
-                rc = _rc;
+
+        clist_node_t *schema_node = namespace->schemas.next;
+
+        do {
+            schema_node = schema_node->next;
+            registry_schema_t *schema = container_of(schema_node, registry_schema_t, node);
+
+            if ((path.schema_id != NULL && *path.schema_id != schema->id) ||
+                schema->instances.next == NULL) {
+                continue;
             }
-        }
-        else {
+
+            clist_node_t *instance_node = schema->instances.next;
+            registry_id_t instance_id = 0;
+
+            do {
+                instance_node = instance_node->next;
+                registry_instance_t *instance = container_of(instance_node, registry_instance_t,
+                                                             node);
+
+                if (path.instance_id == NULL || *path.instance_id == instance_id) {
+                    if (mark_only) {
+                        instance->loaded = true;
+                    }
+                    else {
+                        _registry_lazy_load_instance(namespace_id, schema->id, instance_id,
+                                                     instance);
+                    }
+                }
+
+                instance_id++;
+            } while (instance_node != schema->instances.next);
+        } while (schema_node != namespace->schemas.next);
+    }
+}
+#endif /* CONFIG_REGISTRY_LAZY_LOAD */
+
+/* Resolves the schema and instance of the path without loading the instance lazily */
+static int _registry_lookup_instance(registry_lookup_cache_t *cache, const registry_path_t path)
+{
+    /* reuse the schema and instance of the previous lookup if they did not change */
+    if (cache->instance != NULL &&
+        cache->namespace_id == *path.namespace_id &&
+        cache->schema_id == *path.schema_id &&
+        cache->instance_id == *path.instance_id) {
+        return 0;
+    }
+
+    cache->instance = NULL;
+
+    /* lookup namespace */
+    registry_namespace_t *namespace = _namespace_lookup(*path.namespace_id);
+
+    if (!namespace) {
+        return -EINVAL;
+    }
+
+    /* lookup schema */
+    registry_schema_t *schema = _schema_lookup(namespace, *path.schema_id);
+
+    if (!schema) {
+        return -EINVAL;
+    }
+
+    /* lookup instance */
+    registry_instance_t *instance = _instance_lookup(schema, *path.instance_id);
+
+    if (!instance) {
+        return -EINVAL;
+    }
+
+    cache->namespace_id = *path.namespace_id;
+    cache->schema_id = *path.schema_id;
+    cache->instance_id = *path.instance_id;
+    cache->schema = schema;
+    cache->instance = instance;
+
+    return 0;
+}
+
+static int _registry_lookup(registry_lookup_cache_t *cache, const registry_path_t path)
+{
+    int res = _registry_lookup_instance(cache, path);
+
+    if (res < 0) {
+        return res;
+    }
+
+#if IS_ACTIVE(CONFIG_REGISTRY_LAZY_LOAD)
+    /* the first access of an instance loads its values from the storage facilities */
+    _registry_lazy_load_instance(*path.namespace_id, *path.schema_id, *path.instance_id,
+                                 (registry_instance_t *)cache->instance);
+#endif /* CONFIG_REGISTRY_LAZY_LOAD */
+
+    return 0;
+}
+
+/* Resolves the parameter of the path and the buffer that contains its value inside of the instance */
+static int _registry_lookup_parameter(registry_lookup_cache_t *cache, const registry_path_t path,
+                                      const registry_schema_item_t **param_meta,
+                                      void **intern_val, size_t *intern_val_len)
+{
+    /* lookup namespace, schema and instance */
+    int res = _registry_lookup(cache, path);
+
+    if (res < 0) {
+        return res;
+    }
+
+    /* lookup parameter meta data */
+    *param_meta = _parameter_meta_lookup(path, cache->schema);
+
+    if (!*param_meta) {
+        return -EINVAL;
+    }
+
+    /* get pointer to registry internal value buffer and length */
+    cache->schema->mapping((*param_meta)->id, cache->instance, intern_val, intern_val_len);
+
+    return 0;
+}
+
+/* Writes the value into the buffer of a parameter, converting it to the type of the parameter */
+static int _registry_write_value(const registry_schema_item_t *param_meta, void *intern_val,
+                                 const size_t intern_val_len, const void *val, const int val_len,
+                                 const registry_type_t val_type)
+{
+    /* check if val_type is compatible with param_meta->value_type */
+    if (val_type != param_meta->value_type) {
+#if IS_ACTIVE(CONFIG_REGISTRY_STATS)
+        atomic_fetch_add_u32(&registry_stats.conversions, 1);
+#endif /* CONFIG_REGISTRY_STATS */
+
+        uint8_t new_val[intern_val_len];
+        registry_value_t old_val = {
+            .type = val_type,
+            .buf = val,
+            .buf_len = val_len,
+        };
+        int conversion_error_code = registry_convert_value_to_value(&old_val, new_val,
+                                                                    intern_val_len,
+                                                                    param_meta->value_type);
+        if (conversion_error_code == 0) {
+            /* call handler to apply the new value to the correct parameter in the instance of the schema */
+            memcpy(intern_val, new_val, intern_val_len);
+        }
+        else {
+            return conversion_error_code;
+        }
+    }
+    else {
+        /* call handler to apply the new value to the correct parameter in the instance of the schema */
+        memcpy(intern_val, val, intern_val_len);
+    }
+
+    return 0;
+}
+
+static int _registry_set_value(registry_lookup_cache_t *cache, const registry_path_t path,
+                               const void *val, const int val_len,
+                               const registry_type_t val_type)
+{
+    const registry_schema_item_t *param_meta;
+    size_t intern_val_len;
+    void *intern_val = NULL;
+
+    int res = _registry_lookup_parameter(cache, path, &param_meta, &intern_val, &intern_val_len);
+
+    if (res < 0) {
+        return res;
+    }
+
+    return _registry_write_value(param_meta, intern_val, intern_val_len, val, val_len, val_type);
+}
+
+static int _registry_set(registry_lookup_cache_t *cache, const registry_path_t path,
+                         const void *val, const int val_len, const registry_type_t val_type)
+{
+    _REGISTRY_STATS_START();
+
+    int res = _registry_set_value(cache, path, val, val_len, val_type);
+
+    _REGISTRY_STATS_RECORD(&registry_stats.ops[REGISTRY_STATS_OP_SET], res);
+    _REGISTRY_TRACE(REGISTRY_TRACE_OP_SET, path, res);
+
+    return res;
+}
+
+static int _registry_set_str_value(registry_lookup_cache_t *cache, const registry_path_t path,
+                                   const char *str)
+{
+    const registry_schema_item_t *param_meta;
+    size_t intern_val_len;
+    void *intern_val = NULL;
+
+    int res = _registry_lookup_parameter(cache, path, &param_meta, &intern_val, &intern_val_len);
+
+    if (res < 0) {
+        return res;
+    }
+
+    if (param_meta->value_type != REGISTRY_TYPE_OPAQUE) {
+        /* the string is parsed as the type of the parameter, which only writes it on success */
+        return registry_convert_str_to_value(str, intern_val, intern_val_len,
+                                             param_meta->value_type);
+    }
+
+    /* base64 needs room for its padding, so it is decoded into a buffer of its estimated size.
+       The padding is at most 2 bytes, longer strings can not fit into the parameter and are
+       rejected before their buffer is put on the stack */
+    size_t decoded_len = (strlen(str) + 3) / 4 * 3;
+
+    if (decoded_len > intern_val_len + 2) {
+        return -EINVAL;
+    }
+
+    uint8_t decoded[decoded_len + 1];
+
+    res = registry_convert_str_to_bytes(str, decoded, &decoded_len);
+
+    if (res < 0) {
+        return res;
+    }
+
+    if (decoded_len > intern_val_len) {
+        return -EINVAL;
+    }
+
+    /* shorter values are padded with zeros instead of keeping the end of the old value */
+    memcpy(intern_val, decoded, decoded_len);
+    memset((uint8_t *)intern_val + decoded_len, 0, intern_val_len - decoded_len);
+
+    return 0;
+}
+
+/* Resolves the parameter of the path inside of the instance that was looked up into the cache */
+static int _registry_get_instance_value(const registry_lookup_cache_t *cache,
+                                        const registry_path_t path,
+                                        const registry_type_t requested_val_type,
+                                        registry_value_t *val_buf)
+{
+    const registry_schema_t *schema = cache->schema;
+    const registry_instance_t *instance = cache->instance;
+
+    /* lookup parameter meta data */
+    registry_schema_item_t *param_meta = _parameter_meta_lookup(path, schema);
+
+    if (!param_meta) {
+        return -EINVAL;
+    }
+
+    /* if no specific type was requested, set the registry_value_t type to the type of the schema param */
+    if (requested_val_type == REGISTRY_TYPE_NONE) {
+        val_buf->type = param_meta->value_type;
+    }
+    /* check if the requested val_type is compatible with the actual type of the parameter */
+    else if (requested_val_type != param_meta->value_type) {
+        return -EINVAL;
+    }
+
+    /* call handler to get the parameter value from the instance of the schema */
+    void *buf = NULL;
+    size_t buf_len;
+
+    schema->mapping(param_meta->id, instance, &buf, &buf_len);
+
+    /* update buf pointer in registry_value_t to point to the value inside the registry and set buf_len */
+    val_buf->buf = buf;
+    val_buf->buf_len = buf_len;
+
+    return 0;
+}
+
+static int _registry_get_value(registry_lookup_cache_t *cache, const registry_path_t path,
+                               const registry_type_t requested_val_type,
+                               registry_value_t *val_buf)
+{
+    /* lookup namespace, schema and instance */
+    int res = _registry_lookup(cache, path);
+
+    if (res < 0) {
+        return res;
+    }
+
+    return _registry_get_instance_value(cache, path, requested_val_type, val_buf);
+}
+
+static int _registry_get(registry_lookup_cache_t *cache, const registry_path_t path,
+                         const registry_type_t requested_val_type, registry_value_t *val_buf)
+{
+    _REGISTRY_STATS_START();
+
+    int res = _registry_get_value(cache, path, requested_val_type, val_buf);
+
+    _REGISTRY_STATS_RECORD(&registry_stats.ops[REGISTRY_STATS_OP_GET], res);
+
+    return res;
+}
+
+static int _registry_commit_schema(const registry_path_t path)
+{
+    int rc = 0;
+
+    /* lookup namespace */
+    registry_namespace_t *namespace = _namespace_lookup(*path.namespace_id);
+
+    if (!namespace) {
+        return -EINVAL;
+    }
+
+    /* lookup schema */
+    registry_schema_t *schema = _schema_lookup(namespace, *path.schema_id);
+
+    if (!schema) {
+        return -EINVAL;
+    }
+
+    /* schema/instance */
+    if (path.instance_id != NULL) {
+        /* lookup instance */
+        registry_instance_t *instance = _instance_lookup(schema, *path.instance_id);
+        if (!instance) {
+            return -EINVAL;
+        }
+        if (instance->commit_cb) {
+            registry_path_t new_path = REGISTRY_PATH(*path.namespace_id, *path.schema_id,
+                                                     *path.instance_id);
+            int _rc = instance->commit_cb(new_path, instance->context);
+            if (!_rc) {
+                rc = _rc;
+            }
+        }
+        else {
             rc = -EINVAL;
         }
     }
@@ -476,6 +1193,8 @@ static int _registry_commit_namespace(const registry_path_t path)
 
 int registry_commit(const registry_path_t path)
 {
+    _REGISTRY_STATS_START();
+
     int rc = 0;
 
     if (path.namespace_id != NULL) {
@@ -498,406 +1217,809 @@ int registry_commit(const registry_path_t path)
         }
     }
 
+    _REGISTRY_STATS_RECORD(&registry_stats.ops[REGISTRY_STATS_OP_COMMIT], rc);
+    _REGISTRY_TRACE(REGISTRY_TRACE_OP_COMMIT, path, rc);
+
     return rc;
 }
 
-static void _registry_export_params(int (*export_func)(const registry_path_t path,
-                                                       const registry_schema_t *schema,
-                                                       const registry_instance_t *instance,
-                                                       const registry_schema_item_t *meta,
-                                                       const registry_value_t *value,
-                                                       const void *context),
-                                    const registry_path_t current_path, const registry_schema_t *schema,
-                                    const registry_instance_t *instance, const registry_schema_item_t *schema_items,
-                                    const size_t schema_items_len, const int recursion_depth, const void *context)
-{
-    for (size_t i = 0; i < schema_items_len; i++) {
-        registry_schema_item_t schema_item = schema_items[i];
-
-        /* create new path including the current schema_item */
-        registry_id_t _new_path_path[current_path.path_len + 1];
-        for (size_t j = 0; j < current_path.path_len; j++) {
-            _new_path_path[j] = current_path.path[j];
-        }
-        _new_path_path[ARRAY_SIZE(_new_path_path) - 1] = schema_item.id;
-        registry_path_t new_path = {
-            .namespace_id = current_path.namespace_id,
-            .schema_id = current_path.schema_id,
-            .instance_id = current_path.instance_id,
-            .path = _new_path_path,
-            .path_len = ARRAY_SIZE(_new_path_path),
+static const registry_schema_item_t *_schema_item_lookup(const registry_id_t *path,
+                                                         const size_t path_len,
+                                                         const registry_schema_t *schema)
+{
+    const registry_schema_item_t *schema_items = schema->items;
+    size_t schema_items_len = schema->items_len;
+
+    for (size_t path_index = 0; path_index < path_len; path_index++) {
+        const registry_schema_item_t *schema_item = NULL;
+
+        for (size_t i = 0; i < schema_items_len; i++) {
+            if (schema_items[i].id == path[path_index]) {
+                schema_item = &schema_items[i];
+                break;
+            }
+        }
+
+        if (!schema_item) {
+            return NULL;
+        }
+
+        /* unlike _parameter_meta_lookup, the last path segment can also be a group */
+        if (path_index == path_len - 1) {
+            return schema_item;
+        }
+
+        if (schema_item->kind != REGISTRY_SCHEMA_TYPE_GROUP) {
+            return NULL;
+        }
+
+        schema_items = schema_item->items;
+        schema_items_len = schema_item->items_len;
+    }
+
+    return NULL;
+}
+
+/* levels of the frames of an iterator, every level >= _ITER_LEVEL_ITEMS is a level of schema items */
+#define _ITER_LEVEL_NAMESPACES  0
+#define _ITER_LEVEL_SCHEMAS     1
+#define _ITER_LEVEL_INSTANCES   2
+#define _ITER_LEVEL_ITEMS       3
+
+/* checks if the child of a level is given by the path instead of being walked */
+static bool _registry_iter_is_fixed(const registry_iter_t *iter, const size_t level)
+{
+    return level < iter->fixed_len || (level == _ITER_LEVEL_ITEMS && iter->path_len > 0);
+}
+
+/* nodes that are given by the path are returned with the complete path, like registry_export does */
+static void _registry_iter_set_fixed_path(const registry_iter_t *iter, registry_iter_entry_t *entry)
+{
+    entry->path.schema_id = iter->fixed_len > _ITER_LEVEL_SCHEMAS ?
+                            (registry_id_t *)&iter->schema_id : NULL;
+    entry->path.instance_id = iter->fixed_len > _ITER_LEVEL_INSTANCES ?
+                              (registry_id_t *)&iter->instance_id : NULL;
+    entry->path.path = iter->path_len > 0 ? (registry_id_t *)iter->path : NULL;
+    entry->path.path_len = iter->path_len;
+}
+
+/* pushes the frame of the children of the current node */
+static void _registry_iter_push(registry_iter_t *iter, const int recursion_depth,
+                                const registry_schema_item_t *items, const size_t len,
+                                const clist_node_t *list)
+{
+    registry_iter_frame_t *frame = &iter->frames[iter->frames_len];
+
+    if (_registry_iter_is_fixed(iter, iter->frames_len)) {
+        /* the path continues => the child on the path keeps the recursion depth */
+        *frame = (registry_iter_frame_t) {
+            .recursion_depth = recursion_depth,
         };
+    }
+    /* recursion_depth == 1 means only the node itself without its children */
+    else if (recursion_depth != 1) {
+        *frame = (registry_iter_frame_t) {
+            .items = items,
+            .next = list && list->next ? list->next->next : NULL,
+            .last = list ? list->next : NULL,
+            .index = 0,
+            .len = len,
+            .recursion_depth = recursion_depth == 0 ? 0 : recursion_depth - 1,
+        };
+    }
+    else {
+        return;
+    }
 
-        /* check if the current schema_item is a group or a parameter */
-        if (schema_item.type == REGISTRY_SCHEMA_TYPE_PARAMETER) {
-            /* parameter found => export */
-            registry_value_t val;
-            registry_get_value(new_path, &val);
-            export_func(new_path, schema, instance, &schema_item, &val, context);
-        }
-        else if (schema_item.type == REGISTRY_SCHEMA_TYPE_GROUP) {
-            /* group => search for parameters */
-            registry_schema_group_t group = schema_item.value.group;
-
-            export_func(new_path, schema, instance, &schema_item, NULL, context);
-
-            /* if recursion_depth is not 1 then not only the group itself will be exported, but also its children depending on recursion_depth */
-            if (recursion_depth != 1) {
-                int new_recursion_depth = 0;     // create a new variable, because recursion_depth would otherwise be decreased in each cycle of the for loop
-                if (recursion_depth != 0) {
-                    new_recursion_depth = recursion_depth - 1;
+    iter->frames_len++;
+}
+
+/* checks if registry_iter_next would return another node, without walking to it */
+static bool _registry_iter_has_next(const registry_iter_t *iter)
+{
+    /* the skipped children are reported by the next call */
+    if (iter->skipped) {
+        return true;
+    }
+
+    for (size_t level = 0; level < iter->frames_len; level++) {
+        const registry_iter_frame_t *frame = &iter->frames[level];
+
+        if (_registry_iter_is_fixed(iter, level)) {
+            if (frame->index == 0) {
+                return true;
+            }
+        }
+        else if (level == _ITER_LEVEL_SCHEMAS || level == _ITER_LEVEL_INSTANCES) {
+            if (frame->next != NULL) {
+                return true;
+            }
+        }
+        else if (frame->index < frame->len) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int registry_iter_init(registry_iter_t *iter, const registry_path_t path,
+                       const int recursion_depth)
+{
+    assert(iter != NULL);
+
+    iter->frames_len = 0;
+    iter->fixed_len = 0;
+    iter->path_offset = 0;
+    iter->path_len = 0;
+    iter->schema = NULL;
+    iter->instance = NULL;
+    iter->skipped = false;
+
+    if (path.namespace_id != NULL) {
+        iter->namespace_id = *path.namespace_id;
+        iter->fixed_len++;
+
+        if (path.schema_id != NULL) {
+            iter->schema_id = *path.schema_id;
+            iter->fixed_len++;
+
+            if (path.instance_id != NULL) {
+                iter->instance_id = *path.instance_id;
+                iter->fixed_len++;
+
+                if (path.path_len > REGISTRY_MAX_DIR_DEPTH) {
+                    return -EINVAL;
                 }
 
-                _registry_export_params(export_func, new_path, NULL, NULL, group.items,
-                                        group.items_len, new_recursion_depth, context);
+                iter->path_len = path.path_len;
+                for (size_t i = 0; i < path.path_len; i++) {
+                    iter->path[i] = path.path[i];
+                }
             }
         }
     }
+
+    /* empty path => all namespaces depending on recursion_depth (0 = everything, 1 = nothing, 2 = all namespaces etc.) */
+    _registry_iter_push(iter, recursion_depth, NULL, REGISTRY_ROOT_GROUP_APP + 1, NULL);
+
+    return 0;
 }
 
-static int _registry_export_instance(int (*export_func)(const registry_path_t path,
-                                                        const registry_schema_t *schema,
-                                                        const registry_instance_t *instance,
-                                                        const registry_schema_item_t *meta,
-                                                        const registry_value_t *value,
-                                                        const void *context),
-                                     const registry_path_t path, const registry_schema_t *schema,
-                                     const int recursion_depth, const void *context)
+int registry_iter_next(registry_iter_t *iter, registry_iter_entry_t *entry)
 {
-    registry_instance_t *instance = _instance_lookup(schema, *path.instance_id);
+    assert(iter != NULL);
+    assert(entry != NULL);
 
-    if (!instance) {
+    if (iter->skipped) {
+        iter->skipped = false;
         return -EINVAL;
     }
 
-    /* export instance */
-    export_func(path, schema, instance, NULL, NULL, context);
+    while (iter->frames_len > 0) {
+        const size_t level = iter->frames_len - 1;
+        registry_iter_frame_t *frame = &iter->frames[level];
+        const int recursion_depth = frame->recursion_depth;
+        const bool fixed = _registry_iter_is_fixed(iter, level);
+
+        /* fixed frames only contain the single child given by the path */
+        if (fixed && frame->index > 0) {
+            iter->frames_len--;
+            continue;
+        }
+
+        entry->path = (registry_path_t) {
+            .namespace_id = &iter->namespace_id,
+            .schema_id = NULL,
+            .instance_id = NULL,
+            .path = NULL,
+            .path_len = 0,
+        };
+        entry->schema = NULL;
+        entry->instance = NULL;
+        entry->meta = NULL;
+        entry->value = NULL;
+
+        if (level == _ITER_LEVEL_NAMESPACES) {
+            if (!fixed) {
+                if (frame->index >= frame->len) {
+                    iter->frames_len--;
+                    continue;
+                }
+                iter->namespace_id = frame->index;
+            }
+            frame->index++;
+
+            registry_namespace_t *namespace = _namespace_lookup(iter->namespace_id);
+
+            if (!namespace) {
+                iter->frames_len--;
+                return -EINVAL;
+            }
+
+            if (fixed) {
+                _registry_iter_set_fixed_path(iter, entry);
+            }
+
+            _registry_iter_push(iter, recursion_depth, NULL, 0, &namespace->schemas);
+            return 0;
+        }
+
+        if (level == _ITER_LEVEL_SCHEMAS) {
+            const registry_schema_t *schema;
+
+            if (fixed) {
+                frame->index++;
+                schema = _schema_lookup(_namespace_lookup(iter->namespace_id), iter->schema_id);
+
+                if (!schema) {
+                    iter->frames_len--;
+                    return -EINVAL;
+                }
+            }
+            else {
+                if (!frame->next) {
+                    iter->frames_len--;
+                    continue;
+                }
+
+                clist_node_t *node = frame->next;
+                frame->next = node == frame->last ? NULL : node->next;
+                schema = container_of(node, registry_schema_t, node);
+                iter->schema_id = schema->id;
+            }
+
+            iter->schema = schema;
+            entry->path.schema_id = &iter->schema_id;
+            entry->schema = schema;
+
+            if (fixed) {
+                _registry_iter_set_fixed_path(iter, entry);
+            }
+
+            _registry_iter_push(iter, recursion_depth, NULL, 0, &schema->instances);
+            return 0;
+        }
+
+        entry->path.schema_id = &iter->schema_id;
+        entry->schema = iter->schema;
+
+        if (level == _ITER_LEVEL_INSTANCES) {
+            registry_instance_t *instance;
+
+            if (fixed) {
+                frame->index++;
+                instance = iter->schema->instances.next ?
+                           _instance_lookup(iter->schema, iter->instance_id) : NULL;
+
+                if (!instance) {
+                    iter->frames_len--;
+                    return -EINVAL;
+                }
+            }
+            else {
+                if (!frame->next) {
+                    iter->frames_len--;
+                    continue;
+                }
+
+                clist_node_t *node = frame->next;
+                frame->next = node == frame->last ? NULL : node->next;
+                instance = container_of(node, registry_instance_t, node);
+                iter->instance_id = frame->index;
+                frame->index++;
+            }
+
+#if IS_ACTIVE(CONFIG_REGISTRY_LAZY_LOAD)
+            /* the values of the instance are read directly from it, so it has to be loaded first */
+            _registry_lazy_load_instance(iter->namespace_id, iter->schema_id, iter->instance_id,
+                                         instance);
+#endif /* CONFIG_REGISTRY_LAZY_LOAD */
+
+            iter->instance = instance;
+            entry->path.instance_id = &iter->instance_id;
+            entry->instance = instance;
+
+            if (fixed) {
+                _registry_iter_set_fixed_path(iter, entry);
+            }
+
+            _registry_iter_push(iter, recursion_depth, iter->schema->items,
+                                iter->schema->items_len, NULL);
+            return 0;
+        }
+
+        entry->path.instance_id = &iter->instance_id;
+        entry->instance = iter->instance;
+
+        /* level of schema items */
+        const registry_schema_item_t *schema_item;
+
+        if (fixed) {
+            frame->index++;
+            schema_item = _schema_item_lookup(iter->path, iter->path_len, iter->schema);
+
+            if (!schema_item) {
+                iter->frames_len--;
+                return -EINVAL;
+            }
+
+            /* the parent groups of the item are given by the path, but not walked */
+            iter->path_offset = iter->path_len - 1;
+        }
+        else {
+            if (frame->index >= frame->len) {
+                iter->frames_len--;
+                continue;
+            }
+
+            schema_item = &frame->items[frame->index];
+            frame->index++;
+        }
+
+        /* the ids of the parent groups are already inside of path */
+        const size_t path_index = iter->path_offset + level - _ITER_LEVEL_ITEMS;
+        iter->path[path_index] = schema_item->id;
+        entry->path.path = iter->path;
+        entry->path.path_len = path_index + 1;
+        entry->meta = schema_item;
+
+        /* check if the current schema_item is a group or a parameter */
+        if (schema_item->kind == REGISTRY_SCHEMA_TYPE_PARAMETER) {
+            /* schema and instance are already resolved, so the value does not need a lookup */
+            void *buf = NULL;
+            size_t buf_len;
+
+            iter->schema->mapping(schema_item->id, iter->instance, &buf, &buf_len);
+
+            iter->value = (registry_value_t) {
+                .type = schema_item->value_type,
+                .buf = buf,
+                .buf_len = buf_len,
+            };
+            entry->value = &iter->value;
+        }
+        else if (schema_item->kind == REGISTRY_SCHEMA_TYPE_GROUP) {
+            if (path_index + 1 < REGISTRY_MAX_DIR_DEPTH) {
+                _registry_iter_push(iter, recursion_depth, schema_item->items,
+                                    schema_item->items_len, NULL);
+            }
+            /* children of the group would not fit into path */
+            else if (recursion_depth != 1 && schema_item->items_len > 0) {
+                iter->skipped = true;
+            }
+        }
+
+        return 0;
+    }
+
+    return -ENOENT;
+}
+
+static int _registry_export(int (*export_func)(const registry_path_t path,
+                                               const registry_schema_t *schema,
+                                               const registry_instance_t *instance,
+                                               const registry_schema_item_t *meta,
+                                               const registry_value_t *value,
+                                               const void *context),
+                            const registry_path_t path, const int recursion_depth,
+                            const void *context)
+{
+    assert(export_func != NULL);
+
+#if IS_ACTIVE(CONFIG_REGISTRY_LAZY_LOAD)
+    /* exported values are read directly from the instances, so they have to be loaded first */
+    _registry_lazy_load_path(path, false);
+#endif /* CONFIG_REGISTRY_LAZY_LOAD */
+
+    DEBUG("[registry export] exporting all in ");
+    for (size_t i = 0; i < path.path_len; i++) {
+        DEBUG("/%d", path.path[i]);
+    }
+    DEBUG("\n");
+
+    registry_iter_t iter;
+    registry_iter_entry_t entry;
+    int rc = registry_iter_init(&iter, path, recursion_depth);
+    int res;
+
+    if (rc < 0) {
+        return rc;
+    }
+
+    while ((res = registry_iter_next(&iter, &entry)) != -ENOENT) {
+        if (res == 0) {
+            export_func(entry.path, entry.schema, entry.instance, entry.meta, entry.value,
+                        context);
+        }
+        else {
+            rc = res;
+        }
+    }
+
+    return rc;
+}
+
+int registry_export(int (*export_func)(const registry_path_t path,
+                                       const registry_schema_t *schema,
+                                       const registry_instance_t *instance,
+                                       const registry_schema_item_t *meta,
+                                       const registry_value_t *value,
+                                       const void *context),
+                    const registry_path_t path, const int recursion_depth, const void *context)
+{
+    _REGISTRY_STATS_START();
+
+    int rc = _registry_export(export_func, path, recursion_depth, context);
+
+    _REGISTRY_STATS_RECORD(&registry_stats.ops[REGISTRY_STATS_OP_EXPORT], rc);
+
+    return rc;
+}
+
+/* restores the frames of an iterator as they were right after the node of the token was returned */
+static int _registry_iter_seek(registry_iter_t *iter, const registry_export_token_t *token)
+{
+    registry_namespace_t *namespace = NULL;
+    registry_schema_t *schema = NULL;
+    registry_instance_t *instance = NULL;
+
+    for (size_t level = 0; level < token->level; level++) {
+        /* the node of the token is not a child of the path */
+        if (iter->frames_len != level + 1) {
+            return -EINVAL;
+        }
+
+        registry_iter_frame_t *frame = &iter->frames[level];
+        const bool fixed = _registry_iter_is_fixed(iter, level);
+
+        if (fixed) {
+            frame->index = 1;
+        }
+
+        if (level == _ITER_LEVEL_NAMESPACES) {
+            if (!fixed) {
+                if (token->namespace_id >= frame->len) {
+                    return -EINVAL;
+                }
+                iter->namespace_id = token->namespace_id;
+                frame->index = token->namespace_id + 1;
+            }
+
+            namespace = _namespace_lookup(iter->namespace_id);
+
+            if (!namespace || iter->namespace_id != token->namespace_id) {
+                return -EINVAL;
+            }
+
+            _registry_iter_push(iter, frame->recursion_depth, NULL, 0, &namespace->schemas);
+        }
+        else if (level == _ITER_LEVEL_SCHEMAS) {
+            schema = _schema_lookup(namespace, token->schema_id);
+
+            if (!schema || (fixed && iter->schema_id != token->schema_id)) {
+                return -EINVAL;
+            }
+
+            if (!fixed) {
+                frame->next = &schema->node == frame->last ? NULL : schema->node.next;
+            }
+
+            iter->schema_id = token->schema_id;
+            iter->schema = schema;
+
+            _registry_iter_push(iter, frame->recursion_depth, NULL, 0, &schema->instances);
+        }
+        else if (level == _ITER_LEVEL_INSTANCES) {
+            instance = schema->instances.next ? _instance_lookup(schema, token->instance_id) : NULL;
+
+            if (!instance || (fixed && iter->instance_id != token->instance_id)) {
+                return -EINVAL;
+            }
+
+            if (!fixed) {
+                frame->next = &instance->node == frame->last ? NULL : instance->node.next;
+                frame->index = token->instance_id + 1;
+            }
+
+            iter->instance_id = token->instance_id;
+            iter->instance = instance;
+
+            _registry_iter_push(iter, frame->recursion_depth, schema->items, schema->items_len,
+                                NULL);
+        }
+        else {
+            const registry_schema_item_t *schema_item = NULL;
+
+            if (fixed) {
+                schema_item = _schema_item_lookup(iter->path, iter->path_len, schema);
+                iter->path_offset = iter->path_len - 1;
+            }
 
-    /* schema/instance/item => export concrete schema item with data of the given instance */
-    if (path.path_len > 0) {
-        registry_schema_item_t *schema_item = _parameter_meta_lookup(path, schema);
+            const size_t path_index = iter->path_offset + level - _ITER_LEVEL_ITEMS;
 
-        /* create a new path which does not include the last value, because _registry_export_params will add it inside */
-        registry_id_t _new_path_path[path.path_len - 1];
-        for (size_t j = 0; j < path.path_len; j++) {
-            _new_path_path[j] = path.path[j];
-        }
-        registry_path_t new_path = {
-            .namespace_id = path.namespace_id,
-            .schema_id = path.schema_id,
-            .instance_id = path.instance_id,
-            .path = _new_path_path,
-            .path_len = ARRAY_SIZE(_new_path_path),
-        };
+            if (!fixed) {
+                for (size_t i = 0; i < frame->len; i++) {
+                    if (frame->items[i].id == token->path[path_index]) {
+                        schema_item = &frame->items[i];
+                        frame->index = i + 1;
+                        break;
+                    }
+                }
+            }
 
-        _registry_export_params(export_func, new_path, schema, instance,
-                                schema_item, 1, recursion_depth, context);
-    }
-    /* schema/instance => export the schema instance meta data (name) and its parameters recursively depending on recursion_depth */
-    else if (path.path_len == 0) {
-        /* export instance parameters (recursion_depth == 1 means only the exact path, which would only be a specific instance in this case) */
-        if (recursion_depth != 1) {
-            int new_recursion_depth = 0;
-            if (recursion_depth != 0) {
-                new_recursion_depth = recursion_depth - 1;
+            if (!schema_item || schema_item->id != token->path[path_index]) {
+                return -EINVAL;
             }
 
-            _registry_export_params(export_func, path, schema, instance,
-                                    schema->items,
-                                    schema->items_len, new_recursion_depth, context);
+            iter->path[path_index] = schema_item->id;
+
+            if (schema_item->kind == REGISTRY_SCHEMA_TYPE_GROUP &&
+                path_index + 1 < REGISTRY_MAX_DIR_DEPTH) {
+                _registry_iter_push(iter, frame->recursion_depth, schema_item->items,
+                                    schema_item->items_len, NULL);
+            }
         }
     }
 
     return 0;
 }
 
-static int _registry_export_schema(int (*export_func)(const registry_path_t path,
-                                                      const registry_schema_t *schema,
-                                                      const registry_instance_t *instance,
-                                                      const registry_schema_item_t *meta,
-                                                      const registry_value_t *value,
-                                                      const void *context),
-                                   const registry_path_t path, const int recursion_depth, const void *context)
+int registry_export_page(int (*export_func)(const registry_path_t path,
+                                            const registry_schema_t *schema,
+                                            const registry_instance_t *instance,
+                                            const registry_schema_item_t *meta,
+                                            const registry_value_t *value,
+                                            const void *context),
+                         const registry_path_t path, const int recursion_depth,
+                         registry_export_token_t *token, const size_t max_entries,
+                         const void *context)
 {
-    int rc = 0;
-
-    /* lookup namespace */
-    registry_namespace_t *namespace = _namespace_lookup(*path.namespace_id);
+    assert(export_func != NULL);
+    assert(token != NULL);
 
-    if (!namespace) {
+    if (max_entries == 0) {
         return -EINVAL;
     }
 
-    /* lookup schema */
-    registry_schema_t *schema = _schema_lookup(namespace, *path.schema_id);
+    registry_iter_t iter;
+    registry_iter_entry_t entry;
+    size_t entries = 0;
 
-    if (!schema) {
-        return -EINVAL;
+    int res = registry_iter_init(&iter, path, recursion_depth);
+
+    if (res < 0) {
+        return res;
     }
 
-    /* export schema */
-    export_func(path, schema, NULL, NULL, NULL, context);
+    /* continue behind the last node of the previous page */
+    res = _registry_iter_seek(&iter, token);
 
-    /* get instance, if in path */
-    if (path.instance_id != NULL) {
-        int _rc =
-            _registry_export_instance(export_func, path, schema, recursion_depth, context);
-        if (!_rc) {
-            rc = _rc;
-        }
+    if (res < 0) {
+        return res;
     }
-    /* schema => Export schema meta data (name, description etc.) and its items depending on recursion_depth */
-    else {
-        /* export instances (recursion_depth == 1 means only the exact path, which would only be a specific schema in this case) */
-        if (recursion_depth != 1) {
-            int new_recursion_depth = 0;
-            if (recursion_depth != 0) {
-                new_recursion_depth = recursion_depth - 1;
-            }
 
-            clist_node_t *instance_node = schema->instances.next;
+    while (entries < max_entries) {
+        res = registry_iter_next(&iter, &entry);
 
-            if (!instance_node) {
-                return -EINVAL;
-            }
+        if (res == -ENOENT) {
+            return 0;
+        }
 
-            registry_id_t instance_id = 0;
+        if (res < 0) {
+            return res;
+        }
 
-            do {
-                instance_node = instance_node->next;
-                registry_instance_t *instance = container_of(instance_node, registry_instance_t,
-                                                             node);
+        if (export_func(entry.path, entry.schema, entry.instance, entry.meta, entry.value,
+                        context) != 0) {
+            return entries == 0 ? -ENOBUFS : 1;
+        }
 
-                if (!instance) {
-                    return -EINVAL;
-                }
+        entries++;
 
-                /* create new path that includes the new instance_id */
-                registry_path_t new_path = {
-                    .namespace_id = path.namespace_id,
-                    .schema_id = path.schema_id,
-                    .instance_id = &instance_id,
-                    .path = NULL,
-                    .path_len = 0,
-                };
-
-                int _rc = _registry_export_instance(export_func, new_path, schema,
-                                                    new_recursion_depth,
-                                                    context);
-                if (!_rc) {
-                    rc = _rc;
-                }
+        /* remember the node, the ids of fixed nodes are already set by registry_iter_init */
+        token->namespace_id = iter.namespace_id;
+        token->schema_id = iter.schema_id;
+        token->instance_id = iter.instance_id;
 
-                instance_id++;
-            } while (instance_node != schema->instances.next);
+        if (entry.meta) {
+            token->level = _ITER_LEVEL_ITEMS + entry.path.path_len - iter.path_offset;
+            memcpy(token->path, entry.path.path, entry.path.path_len * sizeof(registry_id_t));
+        }
+        else if (entry.instance) {
+            token->level = _ITER_LEVEL_INSTANCES + 1;
+        }
+        else if (entry.schema) {
+            token->level = _ITER_LEVEL_SCHEMAS + 1;
+        }
+        else {
+            token->level = _ITER_LEVEL_NAMESPACES + 1;
         }
     }
 
-    return rc;
+    /* the page is full, the frames tell if nodes are left without walking to the next one */
+    return _registry_iter_has_next(&iter) ? 1 : 0;
 }
 
-static int _registry_export_namespace(int (*export_func)(const registry_path_t path,
-                                                         const registry_schema_t *schema,
-                                                         const registry_instance_t *instance,
-                                                         const registry_schema_item_t *meta,
-                                                         const registry_value_t *value,
-                                                         const void *context),
-                                      const registry_path_t path, const int recursion_depth, const void *context)
+/* registry_set functions */
+int registry_set_value(const registry_path_t path, const registry_value_t val)
 {
-    int rc = 0;
-
-    /* lookup namespace */
-    registry_namespace_t *namespace = _namespace_lookup(*path.namespace_id);
+    registry_lookup_cache_t cache = { 0 };
 
-    if (!namespace) {
-        return -EINVAL;
-    }
+    return _registry_set(&cache, path, val.buf, val.buf_len, val.type);
+}
 
-    /* export namespace */
-    export_func(path, NULL, NULL, NULL, NULL, context);
+int registry_set_value_cached(registry_lookup_cache_t *cache, const registry_path_t path,
+                              const registry_value_t val)
+{
+    assert(cache != NULL);
 
-    /* get schema, if in path */
-    if (path.schema_id != NULL) {
-        int _rc = _registry_export_schema(export_func, path, recursion_depth, context);
-        if (!_rc) {
-            rc = _rc;
-        }
-    }
-    /* empty path => export everything depending on recursion_depth (0 = everything, 1 = nothing, 2 = all schemas, 3 = all schemas and all their instances etc.) */
-    else {
-        clist_node_t *schema_node = namespace->schemas.next;
+    return _registry_set(cache, path, val.buf, val.buf_len, val.type);
+}
 
-        if (!schema_node) {
-            return -EINVAL;
-        }
+int registry_set_value_decoded(registry_lookup_cache_t *cache, const registry_path_t path,
+                               const registry_value_decode_cb_t decode_cb, void *arg)
+{
+    assert(cache != NULL);
+    assert(decode_cb != NULL);
 
-        if (recursion_depth != 1) {
-            int new_recursion_depth = 0;
-            if (recursion_depth != 0) {
-                new_recursion_depth = recursion_depth - 1;
-            }
+    _REGISTRY_STATS_START();
 
-            do {
-                schema_node = schema_node->next;
-                registry_schema_t *schema = container_of(schema_node, registry_schema_t, node);
-
-                /* create new path that includes the new schema_id */
-                registry_path_t new_path = {
-                    .namespace_id = path.namespace_id,
-                    .schema_id = &schema->id,
-                    .instance_id = NULL,
-                    .path = NULL,
-                    .path_len = 0,
-                };
-
-                int _rc = _registry_export_schema(export_func, new_path, new_recursion_depth,
-                                                  context);
-                if (!_rc) {
-                    rc = _rc;
-                }
-            } while (schema_node != namespace->schemas.next);
-        }
-    }
+    const registry_schema_item_t *param_meta;
+    size_t intern_val_len;
+    void *intern_val = NULL;
 
-    return rc;
-}
+    int res = _registry_lookup_parameter(cache, path, &param_meta, &intern_val, &intern_val_len);
 
-int registry_export(int (*export_func)(const registry_path_t path,
-                                       const registry_schema_t *schema,
-                                       const registry_instance_t *instance,
-                                       const registry_schema_item_t *meta,
-                                       const registry_value_t *value,
-                                       const void *context),
-                    const registry_path_t path, const int recursion_depth, const void *context)
-{
-    assert(export_func != NULL);
+    if (res == 0) {
+        /* decode into a copy, so that a broken value does not change the parameter.
+           uint64_t keeps the copy aligned, and it is never empty */
+        uint64_t buf[intern_val_len / sizeof(uint64_t) + 1];
 
-    int rc = 0;
+        memset(buf, 0, intern_val_len);
 
-    DEBUG("[registry export] exporting all in ");
-    for (size_t i = 0; i < path.path_len; i++) {
-        DEBUG("/%d", path.path[i]);
-    }
-    DEBUG("\n");
+        res = decode_cb(param_meta->value_type, buf, intern_val_len, arg);
 
-    /* get namespace if in path */
-    if (path.namespace_id != NULL) {
-        int _rc = _registry_export_namespace(export_func, path, recursion_depth, context);
-        if (!_rc) {
-            rc = _rc;
+        if (res == 0) {
+            memcpy(intern_val, buf, intern_val_len);
         }
     }
-    else {
-        if (recursion_depth != 1) {
-            int new_recursion_depth = 0;
-            if (recursion_depth != 0) {
-                new_recursion_depth = recursion_depth - 1;
-            }
-
-            /* export sys namespace */
-            int _rc = _registry_export_namespace(export_func,
-                                                 REGISTRY_PATH_SYS(), new_recursion_depth,
-                                                 context);
-            if (!_rc) {
-                rc = _rc;
-            }
 
-            /* export app namespace */
-            _rc = _registry_export_namespace(export_func,
-                                             REGISTRY_PATH_APP(), new_recursion_depth, context);
-            if (!_rc) {
-                rc = _rc;
-            }
-        }
-    }
+    _REGISTRY_STATS_RECORD(&registry_stats.ops[REGISTRY_STATS_OP_SET], res);
+    _REGISTRY_TRACE(REGISTRY_TRACE_OP_SET, path, res);
 
-    return rc;
+    return res;
 }
 
-/* registry_set functions */
-int registry_set_value(const registry_path_t path, const registry_value_t val)
+int registry_set_from_str(const registry_path_t path, const char *str)
 {
-    return _registry_set(path, val.buf, val.buf_len, val.type);
+    assert(str != NULL);
+
+    _REGISTRY_STATS_START();
+
+    registry_lookup_cache_t cache = { 0 };
+    int res = _registry_set_str_value(&cache, path, str);
+
+    _REGISTRY_STATS_RECORD(&registry_stats.ops[REGISTRY_STATS_OP_SET], res);
+    _REGISTRY_TRACE(REGISTRY_TRACE_OP_SET, path, res);
+
+    return res;
 }
 
 int registry_set_opaque(const registry_path_t path, const void *val, const size_t val_len)
 {
-    return _registry_set(path, val, val_len, REGISTRY_TYPE_OPAQUE);
+    registry_lookup_cache_t cache = { 0 };
+
+    return _registry_set(&cache, path, val, val_len, REGISTRY_TYPE_OPAQUE);
 }
 
 int registry_set_string(const registry_path_t path, const char *val)
 {
-    return _registry_set(path, val, strlen(val), REGISTRY_TYPE_STRING);
+    registry_lookup_cache_t cache = { 0 };
+
+    return _registry_set(&cache, path, val, strlen(val), REGISTRY_TYPE_STRING);
 }
 
 int registry_set_bool(const registry_path_t path, const bool val)
 {
-    return _registry_set(path, &val, sizeof(bool), REGISTRY_TYPE_BOOL);
+    registry_lookup_cache_t cache = { 0 };
+
+    return _registry_set(&cache, path, &val, sizeof(bool), REGISTRY_TYPE_BOOL);
 }
 
 int registry_set_uint8(const registry_path_t path, const uint8_t val)
 {
-    return _registry_set(path, &val, sizeof(uint8_t), REGISTRY_TYPE_UINT8);
+    registry_lookup_cache_t cache = { 0 };
+
+    return _registry_set(&cache, path, &val, sizeof(uint8_t), REGISTRY_TYPE_UINT8);
 }
 
 int registry_set_uint16(const registry_path_t path, const uint16_t val)
 {
-    return _registry_set(path, &val, sizeof(uint16_t), REGISTRY_TYPE_UINT16);
+    registry_lookup_cache_t cache = { 0 };
+
+    return _registry_set(&cache, path, &val, sizeof(uint16_t), REGISTRY_TYPE_UINT16);
 }
 
 int registry_set_uint32(const registry_path_t path, const uint32_t val)
 {
-    return _registry_set(path, &val, sizeof(uint32_t), REGISTRY_TYPE_UINT32);
+    registry_lookup_cache_t cache = { 0 };
+
+    return _registry_set(&cache, path, &val, sizeof(uint32_t), REGISTRY_TYPE_UINT32);
 }
 
 #if IS_ACTIVE(CONFIG_REGISTRY_USE_UINT64)
 int registry_set_uint64(const registry_path_t path, const uint64_t val)
 {
-    return _registry_set(path, &val, sizeof(uint16_t), REGISTRY_TYPE_UINT64);
+    registry_lookup_cache_t cache = { 0 };
+
+    return _registry_set(&cache, path, &val, sizeof(uint16_t), REGISTRY_TYPE_UINT64);
 }
 
 #endif /* CONFIG_REGISTRY_USE_UINT64 */
 
 int registry_set_int8(const registry_path_t path, const int8_t val)
 {
-    return _registry_set(path, &val, sizeof(int8_t), REGISTRY_TYPE_INT8);
+    registry_lookup_cache_t cache = { 0 };
+
+    return _registry_set(&cache, path, &val, sizeof(int8_t), REGISTRY_TYPE_INT8);
 }
 
 int registry_set_int16(const registry_path_t path, const int16_t val)
 {
-    return _registry_set(path, &val, sizeof(int16_t), REGISTRY_TYPE_INT16);
+    registry_lookup_cache_t cache = { 0 };
+
+    return _registry_set(&cache, path, &val, sizeof(int16_t), REGISTRY_TYPE_INT16);
 }
 
 int registry_set_int32(const registry_path_t path, const int32_t val)
 {
-    return _registry_set(path, &val, sizeof(int32_t), REGISTRY_TYPE_INT32);
+    registry_lookup_cache_t cache = { 0 };
+
+    return _registry_set(&cache, path, &val, sizeof(int32_t), REGISTRY_TYPE_INT32);
 }
 
 #if IS_ACTIVE(CONFIG_REGISTRY_USE_INT64)
 int registry_set_int64(const registry_path_t path, const int64_t val)
 {
-    return _registry_set(path, &val, sizeof(int64_t), REGISTRY_TYPE_INT64);
+    registry_lookup_cache_t cache = { 0 };
+
+    return _registry_set(&cache, path, &val, sizeof(int64_t), REGISTRY_TYPE_INT64);
 }
 #endif /* CONFIG_REGISTRY_USE_INT64 */
 
 #if IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT32)
 int registry_set_float32(const registry_path_t path, const float val)
 {
-    return _registry_set(path, &val, sizeof(float), REGISTRY_TYPE_FLOAT32);
+    registry_lookup_cache_t cache = { 0 };
+
+    return _registry_set(&cache, path, &val, sizeof(float), REGISTRY_TYPE_FLOAT32);
 }
 #endif /* CONFIG_REGISTRY_USE_FLOAT32 */
 
 #if IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT64)
 int registry_set_float64(const registry_path_t path, const double val)
 {
-    return _registry_set(path, &val, sizeof(double), REGISTRY_TYPE_FLOAT64);
+    registry_lookup_cache_t cache = { 0 };
+
+    return _registry_set(&cache, path, &val, sizeof(double), REGISTRY_TYPE_FLOAT64);
 }
 #endif /* CONFIG_REGISTRY_USE_FLOAT64 */
 
 /* registry_get functions */
 int registry_get_value(const registry_path_t path, registry_value_t *value)
 {
-    return _registry_get(path, REGISTRY_TYPE_NONE, value);
+    registry_lookup_cache_t cache = { 0 };
+
+    return _registry_get(&cache, path, REGISTRY_TYPE_NONE, value);
+}
+
+int registry_get_value_cached(registry_lookup_cache_t *cache, const registry_path_t path,
+                              registry_value_t *value)
+{
+    assert(cache != NULL);
+
+    return _registry_get(cache, path, REGISTRY_TYPE_NONE, value);
 }
 
 static int _registry_get_buf(const registry_path_t path,
@@ -905,9 +2027,10 @@ static int _registry_get_buf(const registry_path_t path,
                              const void **buf,
                              size_t *buf_len)
 {
+    registry_lookup_cache_t cache = { 0 };
     registry_value_t value;
 
-    int res = _registry_get(path, requested_val_type, &value);
+    int res = _registry_get(&cache, path, requested_val_type, &value);
 
     *buf = value.buf;
 
@@ -986,10 +2109,58 @@ int registry_get_float64(const registry_path_t path, const double **buf)
 }
 #endif /* CONFIG_REGISTRY_USE_FLOAT64 */
 
+/* Returns the slot of the load_index that either contains the buffer or is empty, NULL if full */
+static const void **_registry_load_index_lookup(const void *intern_val)
+{
+    size_t mask = ARRAY_SIZE(load_index) - 1;
+    size_t start = (uintptr_t)intern_val & mask;
+    size_t i = start;
+
+    do {
+        if (load_index[i] == intern_val || load_index[i] == NULL) {
+            return &load_index[i];
+        }
+
+        i = (i + 1) & mask;
+    } while (i != start);
+
+    return NULL;
+}
+
 static void _registry_load_cb(const registry_path_t path, const registry_value_t value,
                               const void *cb_arg)
 {
-    (void)cb_arg;
+    assert(cb_arg != NULL);
+    _registry_load_arg_t *load_arg = (_registry_load_arg_t *)cb_arg;
+
+    _REGISTRY_STATS_START();
+
+    const registry_schema_item_t *param_meta;
+    size_t intern_val_len;
+    void *intern_val = NULL;
+
+    int res = _registry_lookup_parameter(&load_cache, path, &param_meta, &intern_val,
+                                         &intern_val_len);
+
+    if (res == 0 && (load_arg->skip_loaded || load_arg->track_loaded)) {
+        const void **slot = _registry_load_index_lookup(intern_val);
+
+        if (load_arg->skip_loaded && slot != NULL && *slot == intern_val) {
+            /* already loaded from a source with a higher priority */
+            return;
+        }
+
+        if (load_arg->track_loaded) {
+            if (slot == NULL) {
+                /* sources with a lower priority could not tell that it was loaded and would
+                   overwrite it, so they are not loaded at all */
+                load_arg->res = -ENOBUFS;
+            }
+            else {
+                *slot = intern_val;
+            }
+        }
+    }
 
     if (ENABLE_DEBUG) {
         DEBUG("[registry_storage_facility] Loading: ");
@@ -999,13 +2170,33 @@ static void _registry_load_cb(const registry_path_t path, const registry_value_t
         DEBUG("\n");
     }
 
-    registry_set_value(path, value);
+    if (res == 0) {
+        res = _registry_write_value(param_meta, intern_val, intern_val_len, value.buf,
+                                    value.buf_len, value.type);
+    }
+
+    _REGISTRY_STATS_RECORD(&registry_stats.ops[REGISTRY_STATS_OP_SET], res);
+    _REGISTRY_TRACE(REGISTRY_TRACE_OP_SET, path, res);
+}
+
+static int _registry_cmp_storage_facility_priority(clist_node_t *a, clist_node_t *b)
+{
+    registry_storage_facility_instance_t *src_a =
+        container_of(a, registry_storage_facility_instance_t, node);
+    registry_storage_facility_instance_t *src_b =
+        container_of(b, registry_storage_facility_instance_t, node);
+
+    /* highest priority first */
+    return src_b->priority - src_a->priority;
 }
 
 void registry_register_storage_facility_src(const registry_storage_facility_instance_t *src)
 {
     assert(src != NULL);
     clist_rpush((clist_node_t *)&storage_facility_srcs, (clist_node_t *)&(src->node));
+
+    /* clist_sort is stable, so sources with the same priority keep their registration order */
+    clist_sort(&storage_facility_srcs, _registry_cmp_storage_facility_priority);
 }
 
 void registry_register_storage_facility_dst(const registry_storage_facility_instance_t *dst)
@@ -1014,7 +2205,7 @@ void registry_register_storage_facility_dst(const registry_storage_facility_inst
     storage_facility_dst = dst;
 }
 
-int registry_load(const registry_path_t path)
+static int _registry_load(const registry_path_t path)
 {
     clist_node_t *node = storage_facility_srcs.next;
 
@@ -1022,37 +2213,77 @@ int registry_load(const registry_path_t path)
         return -ENOENT;
     }
 
+    int rc = 0;
+    _registry_load_arg_t load_arg = {
+        .skip_loaded = false,
+        .track_loaded = false,
+        .res = 0,
+    };
+
+    memset(load_index, 0, sizeof(load_index));
+    load_cache.instance = NULL;
+
+    /* sources are sorted by priority, so the first source that contains a parameter wins */
     do {
+        node = node->next;
         registry_storage_facility_instance_t *src;
         src = container_of(node, registry_storage_facility_instance_t, node);
-        src->itf->load(src, path, _registry_load_cb, NULL);
-    } while (node != storage_facility_srcs.next);
 
-    return 0;
+        /* the last source does not need to remember what it loaded */
+        load_arg.track_loaded = node != storage_facility_srcs.next;
+
+        _REGISTRY_STATS_START();
+
+        int _rc = src->itf->load(src, path, _registry_load_cb, &load_arg);
+
+        _REGISTRY_STATS_RECORD(_registry_stats_storage_facility(src, false), _rc);
+
+        if (_rc != 0) {
+            rc = _rc;
+        }
+
+        load_arg.skip_loaded = true;
+    } while (node != storage_facility_srcs.next && load_arg.res == 0);
+
+    return rc != 0 ? rc : load_arg.res;
 }
 
-static void _registry_storage_facility_dup_check_cb(const registry_path_t path,
-                                                    const registry_value_t val,
-                                                    const void *cb_arg)
+int registry_load(const registry_path_t path)
 {
-    assert(cb_arg != NULL);
-    registry_dup_check_arg_t *dup_arg = (registry_dup_check_arg_t *)cb_arg;
+    _REGISTRY_STATS_START();
 
-    if (path.namespace_id != dup_arg->path.namespace_id ||
-        path.schema_id != dup_arg->path.schema_id ||
-        path.instance_id != dup_arg->path.instance_id) {
-        return;
+#if IS_ACTIVE(CONFIG_REGISTRY_LAZY_LOAD)
+    /* a path without parameter ids loads complete instances, so they must not be loaded lazily anymore */
+    if (path.path_len == 0) {
+        _registry_lazy_load_path(path, true);
     }
 
-    for (size_t i = 0; i < path.path_len; i++) {
-        if (path.path[i] != dup_arg->path.path[i]) {
-            return;
-        }
-    }
+    loading = true;
+    int rc = _registry_load(path);
+    loading = false;
+#else /* CONFIG_REGISTRY_LAZY_LOAD */
+    int rc = _registry_load(path);
+#endif /* CONFIG_REGISTRY_LAZY_LOAD */
+
+    _REGISTRY_STATS_RECORD(&registry_stats.ops[REGISTRY_STATS_OP_LOAD], rc);
+    _REGISTRY_TRACE(REGISTRY_TRACE_OP_LOAD, path, rc);
+
+    return rc;
+}
+
+int registry_load_expected_value(const registry_path_t path, registry_value_t *value)
+{
+    assert(value != NULL);
 
-    if (memcmp(val.buf, dup_arg->val.buf, val.buf_len) == 0) {
-        dup_arg->is_dup = true;
+    /* storage facilities call this from their load function, so the lookup must never start
+       another (lazy) load that would re-enter them */
+    int res = _registry_lookup_instance(&load_cache, path);
+
+    if (res < 0) {
+        return res;
     }
+
+    return _registry_get_instance_value(&load_cache, path, REGISTRY_TYPE_NONE, value);
 }
 
 static int _registry_save_export_func(const registry_path_t path,
@@ -1066,7 +2297,6 @@ static int _registry_save_export_func(const registry_path_t path,
     (void)meta;
     (void)instance;
     (void)context;
-    (void)_registry_storage_facility_dup_check_cb;
 
     /* The registry also exports just the namespace or just a schema, but the storage facility is only interested in paths with values */
     if (value == NULL) {
@@ -1087,39 +2317,160 @@ static int _registry_save_export_func(const registry_path_t path,
         return -ENOENT;
     }
 
-    // TODO use registry_load_one() to remove overhead
-    // registry_dup_check_arg_t dup = {
-    //     .path = path,
-    //     .val = *value,
-    //     .is_dup = false,
-    // };
+    /* skip the parameter if the storage facility already contains the same value */
+    uint32_t stored_hash;
+
+    if (dst->itf->hash && dst->itf->hash(dst, path, &stored_hash) == 0 &&
+        stored_hash == registry_value_hash(value)) {
+        save_stats.skipped++;
+        return 0;
+    }
+
+    _REGISTRY_STATS_START();
 
-    // storage_facility_dst->itf->load(storage_facility_dst, _registry_storage_facility_dup_check_cb, &dup);
+    int res = dst->itf->save(dst, path, *value);
 
-    // if (dup.is_dup) {
-    //     return -EEXIST;
-    // }
+    _REGISTRY_STATS_RECORD(_registry_stats_storage_facility(dst, true), res);
+
+    if (res == 0) {
+        save_stats.saved++;
+    }
+    else if (save_res == 0) {
+        save_res = res;
+    }
 
-    return dst->itf->save(dst, path, *value);
+    return res;
 }
 
 int registry_save(const registry_path_t path)
 {
+    _REGISTRY_STATS_START();
+
     int res;
 
     if (!storage_facility_dst) {
+        _REGISTRY_STATS_RECORD(&registry_stats.ops[REGISTRY_STATS_OP_SAVE], -ENOENT);
+        _REGISTRY_TRACE(REGISTRY_TRACE_OP_SAVE, path, -ENOENT);
         return -ENOENT;
     }
 
+    save_stats.saved = 0;
+    save_stats.skipped = 0;
+    save_res = 0;
+
+#if IS_ACTIVE(CONFIG_REGISTRY_LAZY_LOAD)
+    /* load the instances before the storage facility starts saving, otherwise their default
+       values would overwrite the stored ones */
+    _registry_lazy_load_path(path, false);
+#endif /* CONFIG_REGISTRY_LAZY_LOAD */
+
     if (storage_facility_dst->itf->save_start) {
-        storage_facility_dst->itf->save_start(storage_facility_dst);
+        res = storage_facility_dst->itf->save_start(storage_facility_dst);
+
+        if (res != 0) {
+            _REGISTRY_STATS_RECORD(&registry_stats.ops[REGISTRY_STATS_OP_SAVE], res);
+            _REGISTRY_TRACE(REGISTRY_TRACE_OP_SAVE, path, res);
+            return res;
+        }
     }
 
-    res = registry_export(_registry_save_export_func, path, 0, NULL);
+    res = _registry_export(_registry_save_export_func, path, 0, NULL);
+
+    if (res == 0) {
+        res = save_res;
+    }
 
     if (storage_facility_dst->itf->save_end) {
-        storage_facility_dst->itf->save_end(storage_facility_dst);
+        /* storage facilities that only persist the values at the end report their errors here */
+        int end_res = storage_facility_dst->itf->save_end(storage_facility_dst);
+
+        if (res == 0) {
+            res = end_res;
+        }
     }
 
+    _REGISTRY_STATS_RECORD(&registry_stats.ops[REGISTRY_STATS_OP_SAVE], res);
+    _REGISTRY_TRACE(REGISTRY_TRACE_OP_SAVE, path, res);
+
     return res;
 }
+
+void registry_get_save_stats(registry_save_stats_t *stats)
+{
+    assert(stats != NULL);
+    *stats = save_stats;
+}
+
+#if IS_ACTIVE(CONFIG_REGISTRY_STATS)
+void registry_stats_get(registry_stats_t *stats)
+{
+    assert(stats != NULL);
+    *stats = registry_stats;
+}
+
+void registry_stats_reset(void)
+{
+    memset(&registry_stats, 0, sizeof(registry_stats));
+}
+#endif /* CONFIG_REGISTRY_STATS */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_TRACE)
+size_t registry_trace_drain(registry_trace_cb_t cb, void *context)
+{
+    assert(cb != NULL);
+
+    size_t dropped = 0;
+
+    while (trace_tail != atomic_load_u32(&trace_head)) {
+        /* events older than the size of the buffer were overwritten */
+        if (atomic_load_u32(&trace_head) - trace_tail > CONFIG_REGISTRY_TRACE_SIZE) {
+            trace_tail++;
+            dropped++;
+            continue;
+        }
+
+        if (atomic_load_u32(&trace_buffer[trace_tail & _TRACE_MASK].seq) != trace_tail + 1) {
+            /* the event is still being recorded */
+            break;
+        }
+
+        registry_trace_event_t event = trace_buffer[trace_tail & _TRACE_MASK];
+
+        /* the event could have been overwritten while it was copied */
+        if (atomic_load_u32(&trace_head) - trace_tail > CONFIG_REGISTRY_TRACE_SIZE) {
+            continue;
+        }
+
+        event.seq = trace_tail;
+        trace_tail++;
+        cb(&event, context);
+    }
+
+    return dropped;
+}
+#endif /* CONFIG_REGISTRY_TRACE */
+
+uint32_t registry_crc32(const uint32_t crc, const void *buf, const size_t len)
+{
+    assert(buf != NULL || len == 0);
+
+    /* bitwise CRC32 (IEEE 802.3), a lookup table is not worth the ROM for the small values */
+    const uint8_t *bytes = buf;
+    uint32_t _crc = ~crc;
+
+    for (size_t i = 0; i < len; i++) {
+        _crc ^= bytes[i];
+        for (size_t bit = 0; bit < 8; bit++) {
+            _crc = (_crc >> 1) ^ (0xedb88320 & -(_crc & 1));
+        }
+    }
+
+    return ~_crc;
+}
+
+uint32_t registry_value_hash(const registry_value_t *value)
+{
+    assert(value != NULL);
+
+    return registry_crc32(0, value->buf, value->buf_len);
+}
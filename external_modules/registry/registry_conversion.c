@@ -46,17 +46,17 @@ static int _get_string_len(const registry_value_t *value)
 
     case REGISTRY_TYPE_UINT8: return snprintf(NULL, 0, "%d", *(uint8_t *)value->buf);
     case REGISTRY_TYPE_UINT16: return snprintf(NULL, 0, "%d", *(uint16_t *)value->buf);
-    case REGISTRY_TYPE_UINT32: return snprintf(NULL, 0, "%d", *(uint32_t *)value->buf);
+    case REGISTRY_TYPE_UINT32: return snprintf(NULL, 0, "%" PRIu32, *(uint32_t *)value->buf);
 #if IS_ACTIVE(CONFIG_REGISTRY_USE_UINT64)
-    case REGISTRY_TYPE_UINT64: return snprintf(NULL, 0, "%lld", *(uint64_t *)value->buf);
+    case REGISTRY_TYPE_UINT64: return snprintf(NULL, 0, "%" PRIu64, *(uint64_t *)value->buf);
 #endif /* CONFIG_REGISTRY_USE_UINT64 */
 
     case REGISTRY_TYPE_INT8: return snprintf(NULL, 0, "%d", *(int8_t *)value->buf);
     case REGISTRY_TYPE_INT16: return snprintf(NULL, 0, "%d", *(int16_t *)value->buf);
-    case REGISTRY_TYPE_INT32: return snprintf(NULL, 0, "%d", *(int32_t *)value->buf);
+    case REGISTRY_TYPE_INT32: return snprintf(NULL, 0, "%" PRId32, *(int32_t *)value->buf);
 
 #if IS_ACTIVE(CONFIG_REGISTRY_USE_INT64)
-    case REGISTRY_TYPE_INT64: return snprintf(NULL, 0, "%lld", *(int64_t *)value->buf);
+    case REGISTRY_TYPE_INT64: return snprintf(NULL, 0, "%" PRId64, *(int64_t *)value->buf);
 #endif /* CONFIG_REGISTRY_USE_INT64 */
 
 #if IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT32)
@@ -217,7 +217,14 @@ err:
 int registry_convert_value_to_value(const registry_value_t *src, void *dest,
                                     const size_t dest_len, const registry_type_t dest_type)
 {
-    char string[_get_string_len(src)];
+    const int string_len = _get_string_len(src);
+
+    if (string_len < 0) {
+        return string_len;
+    }
+
+    /* reserve space for the null terminator */
+    char string[string_len + 1];
 
     char *new_string =
         registry_convert_value_to_str(src, string, ARRAY_SIZE(string));
@@ -269,7 +276,7 @@ char *registry_convert_value_to_str(const registry_value_t *src, char *dest,
     case REGISTRY_TYPE_STRING: {
         char *str_val = (char *)src->buf;
 
-        if (strlen(str_val) <= dest_len) {
+        if (strlen(str_val) < dest_len) {
             strcpy(dest, str_val);
             return dest;
         }
@@ -290,7 +297,9 @@ char *registry_convert_value_to_str(const registry_value_t *src, char *dest,
         else if (src->type == REGISTRY_TYPE_UINT32) {
             val_u = *(uint32_t *)src->buf;
         }
-        snprintf(dest, dest_len, " %" PRIu32, val_u);
+        if ((size_t)snprintf(dest, dest_len, "%" PRIu32, val_u) > dest_len - 1) {
+            return NULL;
+        }
         return dest;
 
 #if IS_ACTIVE(CONFIG_REGISTRY_USE_UINT64)
@@ -321,7 +330,9 @@ char *registry_convert_value_to_str(const registry_value_t *src, char *dest,
         else if (src->type == REGISTRY_TYPE_BOOL) {
             val_i = *(bool *)src->buf;
         }
-        snprintf(dest, dest_len, " %" PRId32, val_i);
+        if ((size_t)snprintf(dest, dest_len, "%" PRId32, val_i) > dest_len - 1) {
+            return NULL;
+        }
         return dest;
 
 #if IS_ACTIVE(CONFIG_REGISTRY_USE_INT64)
@@ -338,8 +349,7 @@ char *registry_convert_value_to_str(const registry_value_t *src, char *dest,
 
 #if IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT32)
     case REGISTRY_TYPE_FLOAT32:
-        sprintf(dest, " %f", *(float *)src->buf);
-        len = strlen(dest);
+        len = snprintf(dest, dest_len, "%f", *(float *)src->buf);
         if (len > dest_len - 1) {
             return NULL;
         }
@@ -348,8 +358,7 @@ char *registry_convert_value_to_str(const registry_value_t *src, char *dest,
 
 #if IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT64)
     case REGISTRY_TYPE_FLOAT64:
-        sprintf(dest, " %f", *(double *)src->buf);
-        len = strlen(dest);
+        len = snprintf(dest, dest_len, "%f", *(double *)src->buf);
         if (len > dest_len - 1) {
             return NULL;
         }
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2023 HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_registry RIOT Registry
+ * @ingroup     sys
+ * @brief       RIOT Registry module for handling runtime configurations
+ * @{
+ *
+ * @file
+ *
+ * @author      Lasse Rosenow <lasse.rosenow@haw-hamburg.de>
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+#include <string.h>
+
+#include "registry.h"
+#include "registry_path.h"
+
+/* namespace, schema and instance are the levels above the schema items */
+#define _FIXED_LEVELS 3
+
+/* Amount of ids of the path, namespace, schema and instance are only counted if they are set */
+static size_t _registry_path_depth(const registry_path_t *path)
+{
+    if (path->namespace_id == NULL) {
+        return 0;
+    }
+
+    if (path->schema_id == NULL) {
+        return 1;
+    }
+
+    if (path->instance_id == NULL) {
+        return 2;
+    }
+
+    return _FIXED_LEVELS + path->path_len;
+}
+
+static registry_id_t _registry_path_id(const registry_path_t *path, const size_t level)
+{
+    switch (level) {
+    case 0: return *path->namespace_id;
+    case 1: return *path->schema_id;
+    case 2: return *path->instance_id;
+    }
+
+    return path->path[level - _FIXED_LEVELS];
+}
+
+/* Compares the first depth ids of both paths, which must have at least depth ids */
+static bool _registry_path_ids_equal(const registry_path_t *a, const registry_path_t *b,
+                                     const size_t depth)
+{
+    if (depth > 0 && *a->namespace_id != *b->namespace_id) {
+        return false;
+    }
+
+    if (depth > 1 && *a->schema_id != *b->schema_id) {
+        return false;
+    }
+
+    if (depth > 2 && *a->instance_id != *b->instance_id) {
+        return false;
+    }
+
+    /* the ids of the schema items are compared as whole words instead of bytes */
+    for (size_t i = _FIXED_LEVELS; i < depth; i++) {
+        if (a->path[i - _FIXED_LEVELS] != b->path[i - _FIXED_LEVELS]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool registry_path_equal(const registry_path_t a, const registry_path_t b)
+{
+    const size_t depth = _registry_path_depth(&a);
+
+    if (depth != _registry_path_depth(&b)) {
+        return false;
+    }
+
+    return _registry_path_ids_equal(&a, &b, depth);
+}
+
+bool registry_path_is_prefix(const registry_path_t prefix, const registry_path_t path)
+{
+    const size_t depth = _registry_path_depth(&prefix);
+
+    if (depth > _registry_path_depth(&path)) {
+        return false;
+    }
+
+    return _registry_path_ids_equal(&prefix, &path, depth);
+}
+
+int registry_path_cmp(const registry_path_t a, const registry_path_t b)
+{
+    const size_t a_depth = _registry_path_depth(&a);
+    const size_t b_depth = _registry_path_depth(&b);
+    const size_t depth = a_depth < b_depth ? a_depth : b_depth;
+
+    for (size_t level = 0; level < depth; level++) {
+        const registry_id_t a_id = _registry_path_id(&a, level);
+        const registry_id_t b_id = _registry_path_id(&b, level);
+
+        if (a_id != b_id) {
+            return a_id < b_id ? -1 : 1;
+        }
+    }
+
+    /* one path is a prefix of the other, so the parent comes first */
+    if (a_depth != b_depth) {
+        return a_depth < b_depth ? -1 : 1;
+    }
+
+    return 0;
+}
+
+uint32_t registry_path_hash(const registry_path_t path)
+{
+    const size_t depth = _registry_path_depth(&path);
+    uint32_t crc = 0;
+
+    /* the CRC can be continued, so the ids are hashed without copying them into one array */
+    for (size_t level = 0; level < depth && level < _FIXED_LEVELS; level++) {
+        const registry_id_t id = _registry_path_id(&path, level);
+
+        crc = registry_crc32(crc, &id, sizeof(id));
+    }
+
+    if (depth > _FIXED_LEVELS) {
+        crc = registry_crc32(crc, path.path, path.path_len * sizeof(registry_id_t));
+    }
+
+    return crc;
+}
+
+bool registry_path_packed_equal(const registry_path_packed_t *a, const registry_path_packed_t *b)
+{
+    assert(a != NULL);
+    assert(b != NULL);
+
+    if (a->ids_len != b->ids_len) {
+        return false;
+    }
+
+    return memcmp(a->ids, b->ids, a->ids_len * sizeof(a->ids[0])) == 0;
+}
+
+/** @} */
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2023 HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_registry_bench RIOT Registry Bench
+ * @ingroup     sys
+ * @brief       RIOT Registry Bench module measuring the runtime of the core registry operations
+ *
+ * The benchmark registers synthetic schemas in the app namespace. Every schema
+ * has @ref CONFIG_REGISTRY_BENCH_DEPTH levels of nesting with
+ * @ref CONFIG_REGISTRY_BENCH_PARAMETERS uint32 parameters on each level and
+ * @ref CONFIG_REGISTRY_BENCH_INSTANCES instances.
+ * The results are printed as a CSV table with the columns
+ * `operation,iterations,total_us,ns_per_op`, preceded by a `#` comment line
+ * describing the configuration.
+ *
+ * The scaling benchmark generates schemas of growing size in three shapes:
+ * `wide` (all parameters on the top level), `deep` (the parameters are spread
+ * over @ref REGISTRY_MAX_DIR_DEPTH levels of nesting) and `instances` (many
+ * instances with @ref CONFIG_REGISTRY_BENCH_SCALING_INSTANCE_PARAMETERS
+ * parameters each). Starting with 10 parameters, the size is multiplied by 10
+ * until it exceeds @ref CONFIG_REGISTRY_BENCH_SCALING_MAX_PARAMETERS.
+ * Every row of its CSV table also contains the memory that the generated
+ * schema items (`rom_bytes`) and the instances with their values
+ * (`ram_bytes`) would occupy in an application.
+ * @{
+ *
+ * @file
+ *
+ * @author      Lasse Rosenow <lasse.rosenow@haw-hamburg.de>
+ */
+
+#ifndef REGISTRY_BENCH_H
+#define REGISTRY_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "registry.h"
+
+/**
+ * @brief Amount of synthetic schemas.
+ */
+#ifndef CONFIG_REGISTRY_BENCH_SCHEMAS
+#define CONFIG_REGISTRY_BENCH_SCHEMAS 2
+#endif
+
+/**
+ * @brief Amount of instances per synthetic schema.
+ */
+#ifndef CONFIG_REGISTRY_BENCH_INSTANCES
+#define CONFIG_REGISTRY_BENCH_INSTANCES 4
+#endif
+
+/**
+ * @brief Levels of nesting of the synthetic schemas. Must not exceed @ref REGISTRY_MAX_DIR_DEPTH.
+ */
+#ifndef CONFIG_REGISTRY_BENCH_DEPTH
+#define CONFIG_REGISTRY_BENCH_DEPTH 2
+#endif
+
+/**
+ * @brief Amount of parameters on each level of nesting of the synthetic schemas.
+ */
+#ifndef CONFIG_REGISTRY_BENCH_PARAMETERS
+#define CONFIG_REGISTRY_BENCH_PARAMETERS 4
+#endif
+
+/**
+ * @brief Amount of iterations of every measured operation.
+ */
+#ifndef CONFIG_REGISTRY_BENCH_ITERATIONS
+#define CONFIG_REGISTRY_BENCH_ITERATIONS 1000
+#endif
+
+/**
+ * @brief Id of the first synthetic schema. The following schemas use the consecutive ids.
+ */
+#ifndef CONFIG_REGISTRY_BENCH_SCHEMA_ID
+#define CONFIG_REGISTRY_BENCH_SCHEMA_ID 100
+#endif
+
+/**
+ * @brief Maximum amount of parameters of the scaling benchmark. The generated schemas need
+ * about `(sizeof(registry_schema_item_t) + 4) * CONFIG_REGISTRY_BENCH_SCALING_MAX_PARAMETERS`
+ * bytes of RAM, so 10000 parameters are only feasible on native.
+ */
+#ifndef CONFIG_REGISTRY_BENCH_SCALING_MAX_PARAMETERS
+#define CONFIG_REGISTRY_BENCH_SCALING_MAX_PARAMETERS 1000
+#endif
+
+/**
+ * @brief Amount of parameters per instance of the `instances` shape of the scaling benchmark.
+ */
+#ifndef CONFIG_REGISTRY_BENCH_SCALING_INSTANCE_PARAMETERS
+#define CONFIG_REGISTRY_BENCH_SCALING_INSTANCE_PARAMETERS 10
+#endif
+
+/**
+ * @brief Amount of iterations of the operations of the scaling benchmark that cover a whole
+ * schema (export, save and load). Lookups use @ref CONFIG_REGISTRY_BENCH_ITERATIONS.
+ */
+#ifndef CONFIG_REGISTRY_BENCH_SCALING_ITERATIONS
+#define CONFIG_REGISTRY_BENCH_SCALING_ITERATIONS 10
+#endif
+
+/**
+ * @brief Runs all benchmarks and prints the results.
+ *
+ * It initializes the registry and registers its own storage facilities, so it
+ * has to be run before the application sets up the registry.
+ * Save and load are only measured if the heap storage facility is enabled.
+ *
+ * @return 0 on success, non-zero on failure
+ */
+int registry_bench_run(void);
+
+/**
+ * @brief Runs the scaling benchmark and prints the results.
+ *
+ * It initializes the registry and registers its own storage facility, which
+ * generates the stored values instead of keeping them. The generated schemas
+ * stay registered, so it can only be run once.
+ *
+ * @return 0 on success, -EALREADY if it was already run, other non-zero values on failure
+ */
+int registry_bench_scaling_run(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif /* REGISTRY_BENCH_H */
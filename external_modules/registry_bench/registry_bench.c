@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2023 HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_registry_bench RIOT Registry Bench
+ * @ingroup     sys
+ * @brief       RIOT Registry Bench module measuring the runtime of the core registry operations
+ * @{
+ *
+ * @file
+ *
+ * @author      Lasse Rosenow <lasse.rosenow@haw-hamburg.de>
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "kernel_defines.h"
+#include "ztimer.h"
+#include "registry.h"
+#include "registry_storage_facilities.h"
+
+#include "registry_bench.h"
+
+#if CONFIG_REGISTRY_BENCH_DEPTH < 1 || CONFIG_REGISTRY_BENCH_DEPTH > REGISTRY_MAX_DIR_DEPTH
+#error "CONFIG_REGISTRY_BENCH_DEPTH must be between 1 and REGISTRY_MAX_DIR_DEPTH"
+#endif
+
+/* every level consists of its parameters followed by the group of the next level */
+#define _LEVEL_LEN (CONFIG_REGISTRY_BENCH_PARAMETERS + 1)
+
+typedef struct {
+    uint32_t values[CONFIG_REGISTRY_BENCH_DEPTH][CONFIG_REGISTRY_BENCH_PARAMETERS];
+} _bench_data_t;
+
+static registry_schema_item_t _items[CONFIG_REGISTRY_BENCH_DEPTH][_LEVEL_LEN];
+static registry_schema_t _schemas[CONFIG_REGISTRY_BENCH_SCHEMAS];
+static registry_instance_t _instances[CONFIG_REGISTRY_BENCH_SCHEMAS][CONFIG_REGISTRY_BENCH_INSTANCES];
+static _bench_data_t _data[CONFIG_REGISTRY_BENCH_SCHEMAS][CONFIG_REGISTRY_BENCH_INSTANCES];
+
+/* path of the first parameter at the deepest level */
+static registry_id_t _deep_path[CONFIG_REGISTRY_BENCH_DEPTH];
+
+static bool _registered = false;
+
+#if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP)
+static registry_storage_facility_heap_t _heap_data;
+
+static registry_storage_facility_instance_t _heap_instance = {
+    .itf = &registry_storage_facility_heap,
+    .data = &_heap_data,
+};
+#endif /* CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP */
+
+static void _mapping(const registry_id_t param_id, const registry_instance_t *instance,
+                     void **val, size_t *val_len)
+{
+    _bench_data_t *_instance = (_bench_data_t *)instance->data;
+
+    *val = &_instance->values[param_id / _LEVEL_LEN][param_id % _LEVEL_LEN];
+    *val_len = sizeof(uint32_t);
+}
+
+static int _commit_cb(const registry_path_t path, const void *context)
+{
+    (void)path;
+    (void)context;
+    return 0;
+}
+
+static int _export_func(const registry_path_t path, const registry_schema_t *schema,
+                        const registry_instance_t *instance, const registry_schema_item_t *meta,
+                        const registry_value_t *value, const void *context)
+{
+    (void)path;
+    (void)schema;
+    (void)instance;
+    (void)meta;
+    (void)value;
+    (*(size_t *)context)++;
+    return 0;
+}
+
+static void _setup(void)
+{
+    registry_init();
+
+#if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP)
+    registry_register_storage_facility_src(&_heap_instance);
+    registry_register_storage_facility_dst(&_heap_instance);
+#endif /* CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP */
+
+    /* schemas and instances can only be registered once */
+    if (_registered) {
+        return;
+    }
+    _registered = true;
+
+    for (size_t level = 0; level < CONFIG_REGISTRY_BENCH_DEPTH; level++) {
+        for (size_t i = 0; i < CONFIG_REGISTRY_BENCH_PARAMETERS; i++) {
+            _items[level][i] = (registry_schema_item_t) {
+                .id = level * _LEVEL_LEN + i,
+                _REGISTRY_SCHEMA_ITEM_STRINGS("parameter", "")
+                .kind = REGISTRY_SCHEMA_TYPE_PARAMETER,
+                .value_type = REGISTRY_TYPE_UINT32,
+            };
+        }
+
+        if (level + 1 < CONFIG_REGISTRY_BENCH_DEPTH) {
+            _items[level][CONFIG_REGISTRY_BENCH_PARAMETERS] = (registry_schema_item_t) {
+                .id = level * _LEVEL_LEN + CONFIG_REGISTRY_BENCH_PARAMETERS,
+                _REGISTRY_SCHEMA_ITEM_STRINGS("group", "")
+                .kind = REGISTRY_SCHEMA_TYPE_GROUP,
+                .items = _items[level + 1],
+                .items_len = level + 2 < CONFIG_REGISTRY_BENCH_DEPTH ?
+                             _LEVEL_LEN : CONFIG_REGISTRY_BENCH_PARAMETERS,
+            };
+            _deep_path[level] = _items[level][CONFIG_REGISTRY_BENCH_PARAMETERS].id;
+        }
+        else {
+            _deep_path[level] = _items[level][0].id;
+        }
+    }
+
+    for (size_t s = 0; s < CONFIG_REGISTRY_BENCH_SCHEMAS; s++) {
+        _schemas[s] = (registry_schema_t) {
+            .id = CONFIG_REGISTRY_BENCH_SCHEMA_ID + s,
+            .name = "bench",
+            .description = "",
+            .mapping = _mapping,
+            .items = _items[0],
+            .items_len = CONFIG_REGISTRY_BENCH_DEPTH > 1 ?
+                         _LEVEL_LEN : CONFIG_REGISTRY_BENCH_PARAMETERS,
+        };
+        registry_register_schema(REGISTRY_ROOT_GROUP_APP, &_schemas[s]);
+
+        for (size_t i = 0; i < CONFIG_REGISTRY_BENCH_INSTANCES; i++) {
+            _instances[s][i] = (registry_instance_t) {
+                .name = "bench",
+                .data = &_data[s][i],
+                .commit_cb = _commit_cb,
+            };
+            registry_register_schema_instance(REGISTRY_ROOT_GROUP_APP, _schemas[s].id,
+                                              &_instances[s][i]);
+        }
+    }
+}
+
+static void _print_result(const char *operation, const int param, const uint32_t iterations,
+                          const uint32_t total_us)
+{
+    printf("%s", operation);
+    if (param >= 0) {
+        printf("_%d", param);
+    }
+    printf(",%" PRIu32 ",%" PRIu32 ",%" PRIu64 "\n", iterations, total_us,
+           (uint64_t)total_us * 1000 / iterations);
+}
+
+int registry_bench_run(void)
+{
+    const uint32_t iterations = CONFIG_REGISTRY_BENCH_ITERATIONS;
+    int res = 0;
+    uint32_t start;
+
+    _setup();
+
+    /* the parameter at the deepest level of the last instance is the worst case for lookups */
+    registry_path_t path = {
+        .namespace_id = (registry_namespace_id_t[]) { REGISTRY_ROOT_GROUP_APP },
+        .schema_id = (registry_id_t[]) {
+            CONFIG_REGISTRY_BENCH_SCHEMA_ID + CONFIG_REGISTRY_BENCH_SCHEMAS - 1
+        },
+        .instance_id = (registry_id_t[]) { CONFIG_REGISTRY_BENCH_INSTANCES - 1 },
+        .path = _deep_path,
+        .path_len = CONFIG_REGISTRY_BENCH_DEPTH,
+    };
+    registry_path_t instance_path = path;
+    instance_path.path = NULL;
+    instance_path.path_len = 0;
+
+    printf("# registry_bench schemas=%d instances=%d depth=%d parameters=%d\n",
+           CONFIG_REGISTRY_BENCH_SCHEMAS, CONFIG_REGISTRY_BENCH_INSTANCES,
+           CONFIG_REGISTRY_BENCH_DEPTH, CONFIG_REGISTRY_BENCH_PARAMETERS);
+    printf("operation,iterations,total_us,ns_per_op\n");
+
+    /* get */
+    const uint32_t *val;
+    start = ztimer_now(ZTIMER_USEC);
+    for (uint32_t i = 0; i < iterations; i++) {
+        res |= registry_get_uint32(path, &val);
+    }
+    _print_result("get", -1, iterations, ztimer_now(ZTIMER_USEC) - start);
+
+    /* set with the type of the parameter */
+    start = ztimer_now(ZTIMER_USEC);
+    for (uint32_t i = 0; i < iterations; i++) {
+        res |= registry_set_uint32(path, i);
+    }
+    _print_result("set", -1, iterations, ztimer_now(ZTIMER_USEC) - start);
+
+    /* set with a type that has to be converted */
+    start = ztimer_now(ZTIMER_USEC);
+    for (uint32_t i = 0; i < iterations; i++) {
+        res |= registry_set_uint8(path, (uint8_t)i);
+    }
+    _print_result("set_convert", -1, iterations, ztimer_now(ZTIMER_USEC) - start);
+
+    /* commit */
+    start = ztimer_now(ZTIMER_USEC);
+    for (uint32_t i = 0; i < iterations; i++) {
+        res |= registry_commit(instance_path);
+    }
+    _print_result("commit", -1, iterations, ztimer_now(ZTIMER_USEC) - start);
+
+    /* export the app namespace at every recursion depth, 0 exports everything */
+    registry_path_t namespace_path = REGISTRY_PATH_APP();
+    for (int depth = 0; depth <= 3 + CONFIG_REGISTRY_BENCH_DEPTH; depth++) {
+        size_t exported = 0;
+        start = ztimer_now(ZTIMER_USEC);
+        for (uint32_t i = 0; i < iterations; i++) {
+            res |= registry_export(_export_func, namespace_path, depth, &exported);
+        }
+        _print_result("export_depth", depth, iterations, ztimer_now(ZTIMER_USEC) - start);
+    }
+
+#if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP)
+    /* save and load all synthetic schemas, after the first pass unchanged values are skipped */
+    start = ztimer_now(ZTIMER_USEC);
+    for (uint32_t i = 0; i < iterations; i++) {
+        for (size_t s = 0; s < CONFIG_REGISTRY_BENCH_SCHEMAS; s++) {
+            res |= registry_save(REGISTRY_PATH_APP(_schemas[s].id));
+        }
+    }
+    _print_result("save", -1, iterations, ztimer_now(ZTIMER_USEC) - start);
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (uint32_t i = 0; i < iterations; i++) {
+        for (size_t s = 0; s < CONFIG_REGISTRY_BENCH_SCHEMAS; s++) {
+            res |= registry_load(REGISTRY_PATH_APP(_schemas[s].id));
+        }
+    }
+    _print_result("load", -1, iterations, ztimer_now(ZTIMER_USEC) - start);
+#endif /* CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP */
+
+    return res ? -EINVAL : 0;
+}
+
+/** @} */
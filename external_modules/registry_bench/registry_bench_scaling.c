@@ -0,0 +1,383 @@
+/*
+ * Copyright (C) 2023 HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_registry_bench RIOT Registry Bench
+ * @ingroup     sys
+ * @brief       RIOT Registry Bench module measuring how the registry scales with the size of its schemas
+ * @{
+ *
+ * @file
+ *
+ * @author      Lasse Rosenow <lasse.rosenow@haw-hamburg.de>
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "kernel_defines.h"
+#include "ztimer.h"
+#include "registry.h"
+
+#include "registry_bench.h"
+
+#if CONFIG_REGISTRY_BENCH_SCALING_INSTANCE_PARAMETERS < 1 || \
+    CONFIG_REGISTRY_BENCH_SCALING_INSTANCE_PARAMETERS > CONFIG_REGISTRY_BENCH_SCALING_MAX_PARAMETERS
+#error "CONFIG_REGISTRY_BENCH_SCALING_INSTANCE_PARAMETERS must be between 1 and CONFIG_REGISTRY_BENCH_SCALING_MAX_PARAMETERS"
+#endif
+
+/* the deep shape needs a group on every level in addition to the parameters */
+#define _ITEMS_LEN (CONFIG_REGISTRY_BENCH_SCALING_MAX_PARAMETERS + REGISTRY_MAX_DIR_DEPTH)
+
+#define _INSTANCES_LEN (CONFIG_REGISTRY_BENCH_SCALING_MAX_PARAMETERS / \
+                        CONFIG_REGISTRY_BENCH_SCALING_INSTANCE_PARAMETERS)
+
+typedef enum {
+    _SHAPE_WIDE,
+    _SHAPE_DEEP,
+    _SHAPE_INSTANCES,
+    _SHAPE_NUMOF,
+} _shape_t;
+
+static const char * const _shape_names[_SHAPE_NUMOF] = { "wide", "deep", "instances" };
+
+typedef struct {
+    size_t depth;                               /* levels of nesting */
+    size_t parameters;                          /* parameters per instance */
+    size_t instances;                           /* instances of the schema */
+    registry_id_t path[REGISTRY_MAX_DIR_DEPTH]; /* path of the last parameter on the deepest level */
+} _layout_t;
+
+/* all shapes share the items and values, only the schema of the current shape contains items */
+static registry_schema_item_t _items[_ITEMS_LEN];
+static uint32_t _values[_ITEMS_LEN];
+
+static registry_schema_t _schemas[_SHAPE_NUMOF];
+static registry_instance_t _instances[_SHAPE_NUMOF][_INSTANCES_LEN];
+static size_t _instances_len[_SHAPE_NUMOF];
+
+static _layout_t _layout;
+static const registry_schema_t *_schema;
+
+static bool _done = false;
+
+static void _mapping(const registry_id_t param_id, const registry_instance_t *instance,
+                     void **val, size_t *val_len)
+{
+    uint32_t *values = instance->data;
+
+    *val = &values[param_id];
+    *val_len = sizeof(uint32_t);
+}
+
+static size_t _level_parameters(const _layout_t *layout, const size_t level)
+{
+    return layout->parameters / layout->depth + (level < layout->parameters % layout->depth);
+}
+
+/* Generates the items of a schema with the parameters spread evenly over its levels.
+   Every level consists of its parameters followed by the group of the next level. */
+static size_t _generate_items(_layout_t *layout)
+{
+    size_t pos = 0;
+
+    for (size_t level = 0; level < layout->depth; level++) {
+        const size_t parameters = _level_parameters(layout, level);
+
+        for (size_t i = 0; i < parameters; i++) {
+            _items[pos] = (registry_schema_item_t) {
+                .id = pos,
+                _REGISTRY_SCHEMA_ITEM_STRINGS("parameter", "")
+                .kind = REGISTRY_SCHEMA_TYPE_PARAMETER,
+                .value_type = REGISTRY_TYPE_UINT32,
+            };
+            pos++;
+        }
+
+        if (level + 1 < layout->depth) {
+            _items[pos] = (registry_schema_item_t) {
+                .id = pos,
+                _REGISTRY_SCHEMA_ITEM_STRINGS("group", "")
+                .kind = REGISTRY_SCHEMA_TYPE_GROUP,
+                .items = &_items[pos + 1],
+                .items_len = _level_parameters(layout, level + 1) + (level + 2 < layout->depth),
+            };
+            layout->path[level] = pos;
+            pos++;
+        }
+        else {
+            layout->path[level] = pos - 1;
+        }
+    }
+
+    /* items of the top level */
+    return _level_parameters(layout, 0) + (layout->depth > 1);
+}
+
+/* Implementation of `load`. Generates all parameters of the current schema inside of the path
+   in the same order as a real storage facility would return them */
+static int _load(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                 const load_cb_t cb, const void *cb_arg)
+{
+    (void)instance;
+
+    if (_schema == NULL ||
+        (path.namespace_id != NULL && *path.namespace_id != REGISTRY_ROOT_GROUP_APP) ||
+        (path.schema_id != NULL && *path.schema_id != _schema->id)) {
+        return 0;
+    }
+
+    registry_namespace_id_t namespace_id = REGISTRY_ROOT_GROUP_APP;
+    registry_id_t schema_id = _schema->id;
+    registry_id_t instance_id;
+    registry_id_t ids[REGISTRY_MAX_DIR_DEPTH];
+
+    for (instance_id = 0; instance_id < _layout.instances; instance_id++) {
+        if (path.instance_id != NULL && *path.instance_id != instance_id) {
+            continue;
+        }
+
+        const uint32_t *values = _instances[_schema - _schemas][instance_id].data;
+        registry_path_t parameter_path = {
+            .namespace_id = &namespace_id,
+            .schema_id = &schema_id,
+            .instance_id = &instance_id,
+            .path = ids,
+        };
+        registry_id_t id = 0;
+
+        for (size_t level = 0; level < _layout.depth; level++) {
+            const size_t parameters = _level_parameters(&_layout, level);
+
+            parameter_path.path_len = level + 1;
+
+            for (size_t i = 0; i < parameters; i++) {
+                ids[level] = id;
+                registry_value_t value = {
+                    .type = REGISTRY_TYPE_UINT32,
+                    .buf = &values[id],
+                    .buf_len = sizeof(uint32_t),
+                };
+                cb(parameter_path, value, cb_arg);
+                id++;
+            }
+
+            /* the group of the next level */
+            ids[level] = id;
+            id++;
+        }
+    }
+
+    return 0;
+}
+
+/* Implementation of `save`. The values are generated by `load`, so they are not kept */
+static int _save(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                 const registry_value_t value)
+{
+    (void)instance;
+    (void)path;
+    (void)value;
+    return 0;
+}
+
+static registry_storage_facility_t _storage_facility = {
+    .load = _load,
+    .save = _save,
+};
+
+static registry_storage_facility_instance_t _storage_facility_instance = {
+    .itf = &_storage_facility,
+};
+
+static int _commit_cb(const registry_path_t path, const void *context)
+{
+    (void)path;
+    (void)context;
+    return 0;
+}
+
+static int _export_func(const registry_path_t path, const registry_schema_t *schema,
+                        const registry_instance_t *instance, const registry_schema_item_t *meta,
+                        const registry_value_t *value, const void *context)
+{
+    (void)path;
+    (void)schema;
+    (void)instance;
+    (void)meta;
+    (void)value;
+    (*(size_t *)context)++;
+    return 0;
+}
+
+static void _setup(void)
+{
+    registry_init();
+    registry_register_storage_facility_src(&_storage_facility_instance);
+    registry_register_storage_facility_dst(&_storage_facility_instance);
+
+    /* the schemas do not contain items, until their shape is measured */
+    for (size_t shape = 0; shape < _SHAPE_NUMOF; shape++) {
+        _schemas[shape] = (registry_schema_t) {
+            .id = CONFIG_REGISTRY_BENCH_SCHEMA_ID + CONFIG_REGISTRY_BENCH_SCHEMAS + shape,
+            .name = "bench_scaling",
+            .description = "",
+            .mapping = _mapping,
+            .items = _items,
+            .items_len = 0,
+        };
+        registry_register_schema(REGISTRY_ROOT_GROUP_APP, &_schemas[shape]);
+    }
+}
+
+/* Instances can not be removed, so the sizes have to grow from one measurement to the next */
+static void _register_instances(const _shape_t shape, const size_t instances)
+{
+    while (_instances_len[shape] < instances) {
+        registry_instance_t *instance = &_instances[shape][_instances_len[shape]];
+
+        *instance = (registry_instance_t) {
+            .name = "bench_scaling",
+            .data = &_values[_instances_len[shape] * _layout.parameters],
+            .commit_cb = _commit_cb,
+        };
+        registry_register_schema_instance(REGISTRY_ROOT_GROUP_APP, _schemas[shape].id, instance);
+        _instances_len[shape]++;
+    }
+}
+
+static void _print_result(const _shape_t shape, const char *operation, const uint32_t iterations,
+                          const uint32_t total_us)
+{
+    const size_t items = _layout.parameters + _layout.depth - 1;
+    const size_t rom_bytes = sizeof(registry_schema_t) + items * sizeof(registry_schema_item_t);
+    const size_t ram_bytes = _layout.instances *
+                             (sizeof(registry_instance_t) + _layout.parameters * sizeof(uint32_t));
+
+    printf("%s,%u,%u,%u,%u,%u,%s,%" PRIu32 ",%" PRIu32 ",%" PRIu64 "\n", _shape_names[shape],
+           (unsigned)(_layout.parameters * _layout.instances), (unsigned)_layout.instances,
+           (unsigned)_layout.depth, (unsigned)rom_bytes, (unsigned)ram_bytes, operation,
+           iterations, total_us, (uint64_t)total_us * 1000 / iterations);
+}
+
+static int _measure(const _shape_t shape)
+{
+    const uint32_t iterations = CONFIG_REGISTRY_BENCH_ITERATIONS;
+    const uint32_t scaling_iterations = CONFIG_REGISTRY_BENCH_SCALING_ITERATIONS;
+    registry_schema_t *schema = &_schemas[shape];
+    int res = 0;
+    uint32_t start;
+
+    schema->items_len = _generate_items(&_layout);
+    _register_instances(shape, _layout.instances);
+    _schema = schema;
+
+    /* the last parameter on the deepest level of the last instance is the worst case for lookups */
+    registry_path_t path = {
+        .namespace_id = (registry_namespace_id_t[]) { REGISTRY_ROOT_GROUP_APP },
+        .schema_id = &schema->id,
+        .instance_id = (registry_id_t[]) { _layout.instances - 1 },
+        .path = _layout.path,
+        .path_len = _layout.depth,
+    };
+    registry_path_t schema_path = REGISTRY_PATH_APP(schema->id);
+
+    /* get */
+    registry_value_t value;
+    start = ztimer_now(ZTIMER_USEC);
+    for (uint32_t i = 0; i < iterations; i++) {
+        res |= registry_get_value(path, &value);
+    }
+    _print_result(shape, "get", iterations, ztimer_now(ZTIMER_USEC) - start);
+
+    /* set */
+    start = ztimer_now(ZTIMER_USEC);
+    for (uint32_t i = 0; i < iterations; i++) {
+        res |= registry_set_uint32(path, i);
+    }
+    _print_result(shape, "set", iterations, ztimer_now(ZTIMER_USEC) - start);
+
+    /* export the whole schema */
+    size_t exported = 0;
+    start = ztimer_now(ZTIMER_USEC);
+    for (uint32_t i = 0; i < scaling_iterations; i++) {
+        res |= registry_export(_export_func, schema_path, 0, &exported);
+    }
+    _print_result(shape, "export", scaling_iterations, ztimer_now(ZTIMER_USEC) - start);
+
+    /* save and load the whole schema */
+    start = ztimer_now(ZTIMER_USEC);
+    for (uint32_t i = 0; i < scaling_iterations; i++) {
+        res |= registry_save(schema_path);
+    }
+    _print_result(shape, "save", scaling_iterations, ztimer_now(ZTIMER_USEC) - start);
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (uint32_t i = 0; i < scaling_iterations; i++) {
+        res |= registry_load(schema_path);
+    }
+    _print_result(shape, "load", scaling_iterations, ztimer_now(ZTIMER_USEC) - start);
+
+    /* the items are generated again for the next measurement */
+    schema->items_len = 0;
+    _schema = NULL;
+
+    return res;
+}
+
+int registry_bench_scaling_run(void)
+{
+    int res = 0;
+
+    /* schemas and instances can only be registered once */
+    if (_done) {
+        return -EALREADY;
+    }
+    _done = true;
+
+    _setup();
+
+    printf("# registry_bench_scaling max_parameters=%d instance_parameters=%d\n",
+           CONFIG_REGISTRY_BENCH_SCALING_MAX_PARAMETERS,
+           CONFIG_REGISTRY_BENCH_SCALING_INSTANCE_PARAMETERS);
+    printf("shape,parameters,instances,depth,rom_bytes,ram_bytes,"
+           "operation,iterations,total_us,ns_per_op\n");
+
+    for (size_t shape = 0; shape < _SHAPE_NUMOF; shape++) {
+        for (size_t parameters = 10; parameters <= CONFIG_REGISTRY_BENCH_SCALING_MAX_PARAMETERS;
+             parameters *= 10) {
+            switch (shape) {
+            case _SHAPE_WIDE:
+                _layout.depth = 1;
+                _layout.parameters = parameters;
+                _layout.instances = 1;
+                break;
+            case _SHAPE_DEEP:
+                _layout.depth = parameters < REGISTRY_MAX_DIR_DEPTH ?
+                                parameters : REGISTRY_MAX_DIR_DEPTH;
+                _layout.parameters = parameters;
+                _layout.instances = 1;
+                break;
+            default:
+                _layout.depth = 1;
+                _layout.parameters = CONFIG_REGISTRY_BENCH_SCALING_INSTANCE_PARAMETERS;
+                _layout.instances = parameters > _layout.parameters ?
+                                    parameters / _layout.parameters : 1;
+                break;
+            }
+
+            res |= _measure(shape);
+        }
+    }
+
+    return res ? -EINVAL : 0;
+}
+
+/** @} */
@@ -24,6 +24,20 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Size of the buffer that the machine-readable exports are written through.
+ */
+#ifndef CONFIG_REGISTRY_CLI_OUTPUT_BUF_SIZE
+#define CONFIG_REGISTRY_CLI_OUTPUT_BUF_SIZE 64
+#endif
+
+/**
+ * @brief Default amount of iterations of every operation measured by `registry bench`.
+ */
+#ifndef CONFIG_REGISTRY_CLI_BENCH_ITERATIONS
+#define CONFIG_REGISTRY_CLI_BENCH_ITERATIONS 100
+#endif
+
 extern void registry_cli_init(void);
 extern int registry_cli_cmd(int argc, char **argv);
 
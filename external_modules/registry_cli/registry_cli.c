@@ -1,10 +1,15 @@
 #include <stdint.h>
+#include <inttypes.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
 
 #include "registry.h"
+#include "ztimer.h"
+#if IS_USED(MODULE_REGISTRY_SNAPSHOT)
+#include "registry_snapshot.h"
+#endif /* MODULE_REGISTRY_SNAPSHOT */
 
 #include "registry_cli.h"
 #include "errno.h"
@@ -64,59 +69,6 @@ static registry_namespace_t *_namespace_lookup(const registry_namespace_id_t nam
 }
 
 
-static int _parse_string_path(const char *string_path, registry_id_t *buf, size_t *buf_len)
-{
-    size_t buf_index = 0;
-    char curr_path_segment[REGISTRY_MAX_DIR_NAME_LEN] = { 0 };
-    size_t curr_path_segment_index = 0;
-
-    size_t path_len = strlen(string_path);
-
-    for (size_t i = 0; i <= path_len; i++) {
-        if (string_path[i] == REGISTRY_NAME_SEPARATOR || i == path_len) {
-            buf[buf_index++] = atoi(curr_path_segment);
-            curr_path_segment_index = 0;
-        }
-        else {
-            if (!isdigit(string_path[i])) {
-                return -EINVAL;
-            }
-            curr_path_segment[curr_path_segment_index++] = string_path[i];
-            curr_path_segment[curr_path_segment_index] = '\0';
-        }
-    }
-
-    *buf_len = buf_index;
-    return 0;
-}
-
-static int _registry_path_from_string_path(const char *string_path,
-                                           registry_id_t *path_items_buf,
-                                           size_t *path_items_buf_len,
-                                           registry_path_t *registry_path)
-{
-    int res = _parse_string_path(string_path, path_items_buf, path_items_buf_len);
-
-    if (res < 0) {
-        return res;
-    }
-    else {
-        for (size_t i = 0; i < *path_items_buf_len; i++) {
-            switch (i) {
-            case 0: registry_path->namespace_id = (registry_namespace_id_t *)&path_items_buf[i];
-                break;
-            case 1: registry_path->schema_id = &path_items_buf[i]; break;
-            case 2: registry_path->instance_id = &path_items_buf[i]; break;
-            /* Add path.path to correct position in int_path array */
-            case 3: registry_path->path = &path_items_buf[i]; registry_path->path_len++; break;
-            default: registry_path->path_len++; break;
-            }
-        }
-    }
-
-    return 0;
-}
-
 static int _export_func(const registry_path_t path, const registry_schema_t *schema,
                         const registry_instance_t *instance, const registry_schema_item_t *meta,
                         const registry_value_t *value, const void *context)
@@ -160,16 +112,532 @@ static int _export_func(const registry_path_t path, const registry_schema_t *sch
     }
     else {
         /* Param or Group */
-        printf("%d %s\n", meta->id, meta->name);
+        printf("%d %s\n", meta->id, registry_schema_item_name(meta));
     }
 
     return 0;
 }
 
+typedef enum {
+    _EXPORT_FORMAT_TEXT,
+    _EXPORT_FORMAT_JSON,
+    _EXPORT_FORMAT_CBOR,
+} _export_format_t;
+
+typedef struct {
+    char buf[CONFIG_REGISTRY_CLI_OUTPUT_BUF_SIZE];
+    size_t buf_len;
+} _output_t;
+
+typedef struct {
+    _output_t out;
+    /* names of the groups above the current parameter, NULL if they were not walked */
+    const char *group_names[REGISTRY_MAX_DIR_DEPTH];
+} _json_export_t;
+
+static void _output_flush(_output_t *out)
+{
+    if (out->buf_len > 0) {
+        fwrite(out->buf, 1, out->buf_len, stdout);
+        out->buf_len = 0;
+    }
+}
+
+static void _output_write(_output_t *out, const char *str, size_t len)
+{
+    while (len > 0) {
+        if (out->buf_len == sizeof(out->buf)) {
+            _output_flush(out);
+        }
+
+        size_t chunk_len = sizeof(out->buf) - out->buf_len;
+        if (chunk_len > len) {
+            chunk_len = len;
+        }
+
+        memcpy(&out->buf[out->buf_len], str, chunk_len);
+        out->buf_len += chunk_len;
+        str += chunk_len;
+        len -= chunk_len;
+    }
+}
+
+static void _output_str(_output_t *out, const char *str)
+{
+    _output_write(out, str, strlen(str));
+}
+
+static void _output_char(_output_t *out, const char c)
+{
+    _output_write(out, &c, 1);
+}
+
+static void _output_uint(_output_t *out, uint64_t value)
+{
+    char digits[20];
+    size_t i = sizeof(digits);
+
+    do {
+        digits[--i] = '0' + value % 10;
+        value /= 10;
+    } while (value > 0);
+
+    _output_write(out, &digits[i], sizeof(digits) - i);
+}
+
+static void _output_int(_output_t *out, const int64_t value)
+{
+    if (value < 0) {
+        _output_char(out, '-');
+        _output_uint(out, -(uint64_t)value);
+    }
+    else {
+        _output_uint(out, value);
+    }
+}
+
+static void _output_hex(_output_t *out, const uint8_t *buf, const size_t len)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    for (size_t i = 0; i < len; i++) {
+        _output_char(out, hex[buf[i] >> 4]);
+        _output_char(out, hex[buf[i] & 0xf]);
+    }
+}
+
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT32) || IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT64)
+static void _output_float(_output_t *out, const double value, const int precision)
+{
+    /* JSON has no representation of NaN and infinity */
+    if (isnan(value) || isinf(value)) {
+        _output_str(out, "null");
+        return;
+    }
+
+    /* floats are the only values that need the formatting of printf */
+    char str[32];
+    int len = snprintf(str, sizeof(str), "%.*g", precision, value);
+
+    _output_write(out, str, len);
+}
+#endif /* CONFIG_REGISTRY_USE_FLOAT32 || CONFIG_REGISTRY_USE_FLOAT64 */
+
+/* writes the characters of a JSON string without its quotes */
+static void _output_json_escaped(_output_t *out, const char *str, const size_t len)
+{
+    for (size_t i = 0; i < len && str[i] != '\0'; i++) {
+        const uint8_t c = str[i];
+
+        if (c == '"' || c == '\\') {
+            _output_char(out, '\\');
+            _output_char(out, c);
+        }
+        else if (c < 0x20) {
+            _output_str(out, "\\u00");
+            _output_hex(out, &c, 1);
+        }
+        else {
+            _output_char(out, c);
+        }
+    }
+}
+
+static void _output_json_str(_output_t *out, const char *str, const size_t len)
+{
+    _output_char(out, '"');
+    _output_json_escaped(out, str, len);
+    _output_char(out, '"');
+}
+
+/* names are optional, so nodes without one are written as their id */
+static void _output_json_name(_output_t *out, const char *name, const registry_id_t id)
+{
+    if (name == NULL || name[0] == '\0') {
+        _output_uint(out, id);
+    }
+    else {
+        _output_json_escaped(out, name, SIZE_MAX);
+    }
+}
+
+static const char *_json_type_name(const registry_type_t type)
+{
+    switch (type) {
+    case REGISTRY_TYPE_NONE: return "none";
+    case REGISTRY_TYPE_OPAQUE: return "opaque";
+    case REGISTRY_TYPE_STRING: return "string";
+    case REGISTRY_TYPE_BOOL: return "bool";
+
+    case REGISTRY_TYPE_UINT8: return "uint8";
+    case REGISTRY_TYPE_UINT16: return "uint16";
+    case REGISTRY_TYPE_UINT32: return "uint32";
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_UINT64)
+    case REGISTRY_TYPE_UINT64: return "uint64";
+#endif /* CONFIG_REGISTRY_USE_UINT64 */
+
+    case REGISTRY_TYPE_INT8: return "int8";
+    case REGISTRY_TYPE_INT16: return "int16";
+    case REGISTRY_TYPE_INT32: return "int32";
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_INT64)
+    case REGISTRY_TYPE_INT64: return "int64";
+#endif /* CONFIG_REGISTRY_USE_INT64 */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT32)
+    case REGISTRY_TYPE_FLOAT32: return "float32";
+#endif /* CONFIG_REGISTRY_USE_FLOAT32 */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT64)
+    case REGISTRY_TYPE_FLOAT64: return "float64";
+#endif /* CONFIG_REGISTRY_USE_FLOAT64 */
+    }
+
+    return "unknown";
+}
+
+static void _output_json_value(_output_t *out, const registry_value_t *value)
+{
+    switch (value->type) {
+    case REGISTRY_TYPE_NONE: _output_str(out, "null"); break;
+    case REGISTRY_TYPE_OPAQUE:
+        /* opaque values are written as hex strings */
+        _output_char(out, '"');
+        _output_hex(out, value->buf, value->buf_len);
+        _output_char(out, '"');
+        break;
+    case REGISTRY_TYPE_STRING: _output_json_str(out, value->buf, value->buf_len); break;
+    case REGISTRY_TYPE_BOOL: _output_str(out, *(bool *)value->buf ? "true" : "false"); break;
+
+    case REGISTRY_TYPE_UINT8: _output_uint(out, *(uint8_t *)value->buf); break;
+    case REGISTRY_TYPE_UINT16: _output_uint(out, *(uint16_t *)value->buf); break;
+    case REGISTRY_TYPE_UINT32: _output_uint(out, *(uint32_t *)value->buf); break;
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_UINT64)
+    case REGISTRY_TYPE_UINT64: _output_uint(out, *(uint64_t *)value->buf); break;
+#endif /* CONFIG_REGISTRY_USE_UINT64 */
+
+    case REGISTRY_TYPE_INT8: _output_int(out, *(int8_t *)value->buf); break;
+    case REGISTRY_TYPE_INT16: _output_int(out, *(int16_t *)value->buf); break;
+    case REGISTRY_TYPE_INT32: _output_int(out, *(int32_t *)value->buf); break;
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_INT64)
+    case REGISTRY_TYPE_INT64: _output_int(out, *(int64_t *)value->buf); break;
+#endif /* CONFIG_REGISTRY_USE_INT64 */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT32)
+    case REGISTRY_TYPE_FLOAT32: _output_float(out, *(float *)value->buf, 9); break;
+#endif /* CONFIG_REGISTRY_USE_FLOAT32 */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT64)
+    case REGISTRY_TYPE_FLOAT64: _output_float(out, *(double *)value->buf, 17); break;
+#endif /* CONFIG_REGISTRY_USE_FLOAT64 */
+    }
+}
+
+static int _json_export_func(const registry_path_t path, const registry_schema_t *schema,
+                             const registry_instance_t *instance,
+                             const registry_schema_item_t *meta, const registry_value_t *value,
+                             const void *context)
+{
+    _json_export_t *export = (_json_export_t *)context;
+    _output_t *out = &export->out;
+
+    if (meta == NULL) {
+        if (instance != NULL) {
+            /* the groups of the previous instance are not the parents of the next parameters */
+            memset(export->group_names, 0, sizeof(export->group_names));
+        }
+
+        return 0;
+    }
+
+    if (value == NULL) {
+        /* only parameters are exported, groups are just remembered for their names */
+        export->group_names[path.path_len - 1] = registry_schema_item_name(meta);
+        return 0;
+    }
+
+    _output_str(out, "{\"path\":[");
+    _output_uint(out, *path.namespace_id);
+    _output_char(out, ',');
+    _output_uint(out, *path.schema_id);
+    _output_char(out, ',');
+    _output_uint(out, *path.instance_id);
+    for (size_t i = 0; i < path.path_len; i++) {
+        _output_char(out, ',');
+        _output_uint(out, path.path[i]);
+    }
+
+    /* the name path is built from one string per level, so it is written piece by piece */
+    _output_str(out, "],\"name\":\"");
+    _output_json_name(out, _namespace_lookup(*path.namespace_id)->name, *path.namespace_id);
+    _output_char(out, '/');
+    _output_json_name(out, schema->name, *path.schema_id);
+    _output_char(out, '/');
+    _output_json_name(out, instance->name, *path.instance_id);
+    for (size_t i = 0; i + 1 < path.path_len; i++) {
+        /* the parent groups of a directly exported parameter are not walked and have no name */
+        _output_char(out, '/');
+        _output_json_name(out, export->group_names[i], path.path[i]);
+    }
+    _output_char(out, '/');
+    _output_json_name(out, registry_schema_item_name(meta), meta->id);
+
+    _output_str(out, "\",\"type\":\"");
+    _output_str(out, _json_type_name(value->type));
+    _output_str(out, "\",\"value\":");
+    _output_json_value(out, value);
+    _output_str(out, "}\n");
+
+    return 0;
+}
+
+#if IS_USED(MODULE_REGISTRY_SNAPSHOT)
+static int _cbor_write_cb(const void *buf, const size_t len, void *arg)
+{
+    _output_hex(arg, buf, len);
+    return 0;
+}
+#endif /* MODULE_REGISTRY_SNAPSHOT */
+
+static int _export(const registry_path_t path, const int recursion_depth,
+                   const _export_format_t format)
+{
+    int res = -ENOTSUP;
+
+    switch (format) {
+    case _EXPORT_FORMAT_TEXT:
+        return registry_export(_export_func, path, recursion_depth, NULL);
+    case _EXPORT_FORMAT_JSON: {
+        _json_export_t export = { .out.buf_len = 0 };
+
+        res = registry_export(_json_export_func, path, recursion_depth, &export);
+        _output_flush(&export.out);
+        break;
+    }
+    case _EXPORT_FORMAT_CBOR: {
+#if IS_USED(MODULE_REGISTRY_SNAPSHOT)
+        /* snapshots always contain all parameters below the path */
+        _output_t out = { .buf_len = 0 };
+
+        (void)recursion_depth;
+        res = registry_snapshot_write(path, _cbor_write_cb, &out);
+        _output_char(&out, '\n');
+        _output_flush(&out);
+#endif /* MODULE_REGISTRY_SNAPSHOT */
+        break;
+    }
+    }
+
+    return res;
+}
+
+typedef struct {
+    const char *name;
+    int (*op)(const registry_path_t path, const registry_value_t *value);
+} _bench_op_t;
+
+static int _bench_export_func(const registry_path_t path, const registry_schema_t *schema,
+                              const registry_instance_t *instance,
+                              const registry_schema_item_t *meta,
+                              const registry_value_t *value, const void *context)
+{
+    (void)path;
+    (void)schema;
+    (void)instance;
+    (void)meta;
+    (void)value;
+    (void)context;
+    return 0;
+}
+
+static int _bench_get(const registry_path_t path, const registry_value_t *value)
+{
+    registry_value_t current;
+
+    (void)value;
+    return registry_get_value(path, &current);
+}
+
+static int _bench_set(const registry_path_t path, const registry_value_t *value)
+{
+    return registry_set_value(path, *value);
+}
+
+static int _bench_commit(const registry_path_t path, const registry_value_t *value)
+{
+    (void)value;
+    return registry_commit(path);
+}
+
+static int _bench_export(const registry_path_t path, const registry_value_t *value)
+{
+    (void)path;
+    (void)value;
+    return registry_export(_bench_export_func, _REGISTRY_PATH_0(), 0, NULL);
+}
+
+static int _bench_save(const registry_path_t path, const registry_value_t *value)
+{
+    (void)path;
+    (void)value;
+    return registry_save(_REGISTRY_PATH_0());
+}
+
+static int _bench_load(const registry_path_t path, const registry_value_t *value)
+{
+    (void)path;
+    (void)value;
+    return registry_load(_REGISTRY_PATH_0());
+}
+
+static int _bench(const registry_path_t path, const uint32_t iterations, const bool storage)
+{
+    /* get, set and commit use the given parameter, the others cover the whole registry */
+    static const _bench_op_t ops[] = {
+        { .name = "get", .op = _bench_get },
+        { .name = "set", .op = _bench_set },
+        { .name = "commit", .op = _bench_commit },
+        { .name = "export", .op = _bench_export },
+        /* save rewrites the storage destination and load overwrites unsaved values in RAM,
+         * so both only run on request */
+        { .name = "save", .op = _bench_save },
+        { .name = "load", .op = _bench_load },
+    };
+    const size_t ops_len = storage ? ARRAY_SIZE(ops) : ARRAY_SIZE(ops) - 2;
+    registry_value_t value;
+    int res = registry_get_value(path, &value);
+
+    if (res != 0) {
+        return res;
+    }
+
+    /* the current value is set again, so the benchmark does not change the configuration */
+    uint8_t buf[value.buf_len];
+
+    memcpy(buf, value.buf, value.buf_len);
+    value.buf = buf;
+
+    printf("operation,iterations,min_us,avg_us,max_us,errors\n");
+
+    for (size_t i = 0; i < ops_len; i++) {
+        uint32_t min = UINT32_MAX;
+        uint32_t max = 0;
+        uint64_t total = 0;
+        uint32_t errors = 0;
+
+        for (uint32_t j = 0; j < iterations; j++) {
+            uint32_t start = ztimer_now(ZTIMER_USEC);
+
+            if (ops[i].op(path, &value) != 0) {
+                errors++;
+            }
+
+            uint32_t duration = ztimer_now(ZTIMER_USEC) - start;
+
+            min = duration < min ? duration : min;
+            max = duration > max ? duration : max;
+            total += duration;
+        }
+
+        printf("%s,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 "\n", ops[i].name,
+               iterations, min, (uint32_t)(total / iterations), max, errors);
+    }
+
+    return 0;
+}
+
+#if IS_ACTIVE(CONFIG_REGISTRY_STATS)
+static void _print_stats_counter(const char *name, const registry_stats_counter_t *counter)
+{
+    printf("%s: %" PRIu32 " calls, %" PRIu32 " errors, latency (us)", name, counter->calls,
+           counter->errors);
+
+    for (size_t i = 0; i < CONFIG_REGISTRY_STATS_HISTOGRAM_BUCKETS; i++) {
+        if (counter->histogram[i] == 0) {
+            continue;
+        }
+
+        if (i + 1 < CONFIG_REGISTRY_STATS_HISTOGRAM_BUCKETS) {
+            printf(" <%lu:%" PRIu32, 1UL << i, counter->histogram[i]);
+        }
+        else {
+            printf(" >=%lu:%" PRIu32, 1UL << (i - 1), counter->histogram[i]);
+        }
+    }
+
+    printf("\n");
+}
+
+static void _print_stats(void)
+{
+    static const char * const op_names[REGISTRY_STATS_OP_NUMOF] = {
+        [REGISTRY_STATS_OP_GET] = "get",
+        [REGISTRY_STATS_OP_SET] = "set",
+        [REGISTRY_STATS_OP_COMMIT] = "commit",
+        [REGISTRY_STATS_OP_EXPORT] = "export",
+        [REGISTRY_STATS_OP_LOAD] = "load",
+        [REGISTRY_STATS_OP_SAVE] = "save",
+    };
+    registry_stats_t stats;
+
+    registry_stats_get(&stats);
+
+    for (size_t i = 0; i < REGISTRY_STATS_OP_NUMOF; i++) {
+        _print_stats_counter(op_names[i], &stats.ops[i]);
+    }
+
+    printf("conversions: %" PRIu32 "\n", stats.conversions);
+
+    for (size_t i = 0; i < CONFIG_REGISTRY_STATS_STORAGE_FACILITIES; i++) {
+        if (stats.storage_facilities[i].instance == NULL) {
+            break;
+        }
+
+        printf("storage facility %d ", (int)i);
+        _print_stats_counter("load", &stats.storage_facilities[i].load);
+        printf("storage facility %d ", (int)i);
+        _print_stats_counter("save", &stats.storage_facilities[i].save);
+    }
+}
+#endif /* CONFIG_REGISTRY_STATS */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_TRACE)
+static void _print_trace_event(const registry_trace_event_t *event, void *context)
+{
+    (void)context;
+
+    static const char * const op_names[] = {
+        [REGISTRY_TRACE_OP_SET] = "set",
+        [REGISTRY_TRACE_OP_COMMIT] = "commit",
+        [REGISTRY_TRACE_OP_LOAD] = "load",
+        [REGISTRY_TRACE_OP_SAVE] = "save",
+    };
+
+    printf("%" PRIu32 " %" PRIu32 "ms pid %d %s ", event->seq, event->timestamp, event->pid,
+           op_names[event->op]);
+
+    if (event->path_len == 0) {
+        printf("/");
+    }
+    else {
+        printf("%d", event->namespace_id);
+    }
+
+    for (size_t i = 1; i < event->path_len; i++) {
+        if (i > CONFIG_REGISTRY_TRACE_PATH_LEN) {
+            printf("/...");
+            break;
+        }
+
+        printf("/%" PRIu32, event->ids[i - 1]);
+    }
+
+    printf(" res %d\n", event->res);
+}
+#endif /* CONFIG_REGISTRY_TRACE */
+
 int registry_cli_cmd(int argc, char **argv)
 {
-    size_t path_items_buf_len = REGISTRY_MAX_DIR_DEPTH + 3;
-    registry_id_t path_items_buf[path_items_buf_len];
+    registry_id_t path_items_buf[REGISTRY_MAX_DIR_DEPTH + 3];
     // TODO: Why is REGISTRY_PATH() Not working? (It should resolve to _REGISTRY_PATH_0()
     // but somehow its not initializing namespace with NULL?? (makes no sense:( ... )))
     registry_path_t path = _REGISTRY_PATH_0();
@@ -180,8 +648,7 @@ int registry_cli_cmd(int argc, char **argv)
     }
 
     if (strcmp(argv[1], "get") == 0) {
-        if (_registry_path_from_string_path(argv[2], path_items_buf, &path_items_buf_len,
-                                            &path) < 0) {
+        if (registry_path_from_names(argv[2], path_items_buf, &path) < 0) {
             printf("usage: %s %s <path>\n", argv[0], argv[1]);
             return 1;
         }
@@ -200,18 +667,61 @@ int registry_cli_cmd(int argc, char **argv)
         return 0;
     }
     else if (strcmp(argv[1], "set") == 0) {
-        if (_registry_path_from_string_path(argv[2], path_items_buf, &path_items_buf_len,
-                                            &path) < 0) {
-            printf("usage: %s %s <path> <value>\n", argv[0], argv[1]);
+        /* "set <path> <value>" sets a single parameter, otherwise every argument is a pair */
+        if (argc == 4 && strchr(argv[2], '=') == NULL) {
+            if (registry_path_from_names(argv[2], path_items_buf, &path) < 0) {
+                printf("error: %s not found\n", argv[2]);
+                return 1;
+            }
+
+            int res = registry_set_from_str(path, argv[3]);
+
+            if (res != 0) {
+                printf("error: %d\n", res);
+                return 1;
+            }
+
+            return 0;
+        }
+
+        if (argc < 3) {
+            printf("usage: %s %s {<path> <value>|<path>=<value> [<path>=<value> ...]}\n",
+                   argv[0], argv[1]);
             return 1;
         }
 
-        registry_set_string(path, argv[3]);
-        return 0;
+        int failed = 0;
+
+        for (int i = 2; i < argc; i++) {
+            /* values can contain '=' (e.g. base64 padding), so only the first one separates */
+            char *value = strchr(argv[i], '=');
+
+            if (value == NULL) {
+                printf("error: %s is not a <path>=<value> pair\n", argv[i]);
+                failed++;
+                continue;
+            }
+
+            *value++ = '\0';
+
+            if (registry_path_from_names(argv[i], path_items_buf, &path) < 0) {
+                printf("error: %s not found\n", argv[i]);
+                failed++;
+                continue;
+            }
+
+            int res = registry_set_from_str(path, value);
+
+            if (res != 0) {
+                printf("error: %d %s\n", res, argv[i]);
+                failed++;
+            }
+        }
+
+        return failed > 0 ? 1 : 0;
     }
     else if (strcmp(argv[1], "commit") == 0) {
-        if (_registry_path_from_string_path(argv[2], path_items_buf, &path_items_buf_len,
-                                            &path) < 0) {
+        if (registry_path_from_names(argv[2], path_items_buf, &path) < 0) {
             printf("usage: %s %s <path>\n", argv[0], argv[1]);
             return 1;
         }
@@ -220,33 +730,59 @@ int registry_cli_cmd(int argc, char **argv)
         return 0;
     }
     else if (strcmp(argv[1], "export") == 0) {
-        /* If the path is invalid, it can also just be non existent, so other arguments like -r need to be checked */
-        bool invalid_path = false;
-        if (_registry_path_from_string_path(argv[2], path_items_buf, &path_items_buf_len,
-                                            &path) < 0) {
-            invalid_path = true;
-        }
-        if (invalid_path && strcmp(argv[2], "-r") != 0) {
-            printf("usage: %s %s <path> [-r <recursion depth>]\n", argv[0], argv[1]);
-            return 1;
-        }
-
-        /* The argv index of -r varies depending on if a path was specified or not */
         int recursion_level = 0;
-        if (invalid_path && argc > 3 && strcmp(argv[2], "-r") == 0) {
-            recursion_level = atoi(argv[3]);
+        _export_format_t format = _EXPORT_FORMAT_TEXT;
+        bool has_path = false;
+
+        for (int i = 2; i < argc; i++) {
+            if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+                recursion_level = atoi(argv[++i]);
+            }
+            else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+                i++;
+                if (strcmp(argv[i], "text") == 0) {
+                    format = _EXPORT_FORMAT_TEXT;
+                }
+                else if (strcmp(argv[i], "json") == 0) {
+                    format = _EXPORT_FORMAT_JSON;
+                }
+#if IS_USED(MODULE_REGISTRY_SNAPSHOT)
+                else if (strcmp(argv[i], "cbor") == 0) {
+                    format = _EXPORT_FORMAT_CBOR;
+                }
+#endif /* MODULE_REGISTRY_SNAPSHOT */
+                else {
+                    goto export_usage;
+                }
+            }
+            else if (!has_path && registry_path_from_names(argv[i], path_items_buf, &path) == 0) {
+                has_path = true;
+            }
+            else {
+                goto export_usage;
+            }
         }
-        else if (argc > 4 && strcmp(argv[3], "-r") == 0) {
-            recursion_level = atoi(argv[4]);
+
+        int res = _export(path, recursion_level, format);
+
+        if (res != 0) {
+            printf("error: %d\n", res);
+            return 1;
         }
 
-        registry_export(_export_func, path, recursion_level, NULL);
         return 0;
+
+export_usage:
+        printf("usage: %s %s [path] [-r <recursion depth>] [-f {text|json"
+#if IS_USED(MODULE_REGISTRY_SNAPSHOT)
+               "|cbor"
+#endif /* MODULE_REGISTRY_SNAPSHOT */
+               "}]\n", argv[0], argv[1]);
+        return 1;
     }
     else if (strcmp(argv[1], "load") == 0) {
         if (argc > 2) {
-            if (_registry_path_from_string_path(argv[2], path_items_buf, &path_items_buf_len,
-                                                &path) < 0) {
+            if (registry_path_from_names(argv[2], path_items_buf, &path) < 0) {
                 printf("usage: %s %s [path]\n", argv[0], argv[1]);
                 return 1;
             }
@@ -262,8 +798,7 @@ int registry_cli_cmd(int argc, char **argv)
     }
     else if (strcmp(argv[1], "save") == 0) {
         if (argc > 2) {
-            if (_registry_path_from_string_path(argv[2], path_items_buf, &path_items_buf_len,
-                                                &path) < 0) {
+            if (registry_path_from_names(argv[2], path_items_buf, &path) < 0) {
                 printf("usage: %s %s [path]\n", argv[0], argv[1]);
                 return 1;
             }
@@ -275,11 +810,86 @@ int registry_cli_cmd(int argc, char **argv)
             registry_save(_REGISTRY_PATH_0());
         }
 
+        registry_save_stats_t stats;
+        registry_get_save_stats(&stats);
+        printf("saved: %d, skipped (unchanged): %d\n", (int)stats.saved, (int)stats.skipped);
+
+        return 0;
+    }
+
+    else if (strcmp(argv[1], "bench") == 0) {
+        uint32_t iterations = CONFIG_REGISTRY_CLI_BENCH_ITERATIONS;
+        bool storage = false;
+        bool has_iterations = false;
+
+        if (argc < 3 || registry_path_from_names(argv[2], path_items_buf, &path) < 0 ||
+            path.path_len == 0) {
+            goto bench_usage;
+        }
+
+        for (int i = 3; i < argc; i++) {
+            if (strcmp(argv[i], "-s") == 0) {
+                storage = true;
+            }
+            else if (!has_iterations && (iterations = strtoul(argv[i], NULL, 10)) > 0) {
+                has_iterations = true;
+            }
+            else {
+                goto bench_usage;
+            }
+        }
+
+        int res = _bench(path, iterations, storage);
+
+        if (res != 0) {
+            printf("error: %d\n", res);
+            return 1;
+        }
+
+        return 0;
+
+bench_usage:
+        /* -s also benchmarks save and load, which write to the storage destination */
+        printf("usage: %s %s <parameter path> [iterations] [-s]\n", argv[0], argv[1]);
+        return 1;
+    }
+#if IS_ACTIVE(CONFIG_REGISTRY_STATS)
+    else if (strcmp(argv[1], "stats") == 0) {
+        if (argc > 2) {
+            if (strcmp(argv[2], "reset") != 0) {
+                printf("usage: %s %s [reset]\n", argv[0], argv[1]);
+                return 1;
+            }
+
+            registry_stats_reset();
+            return 0;
+        }
+
+        _print_stats();
+        return 0;
+    }
+#endif /* CONFIG_REGISTRY_STATS */
+#if IS_ACTIVE(CONFIG_REGISTRY_TRACE)
+    else if (strcmp(argv[1], "trace") == 0) {
+        size_t dropped = registry_trace_drain(_print_trace_event, NULL);
+
+        if (dropped > 0) {
+            printf("dropped: %d\n", (int)dropped);
+        }
+
         return 0;
     }
+#endif /* CONFIG_REGISTRY_TRACE */
 
 help_error:
-    printf("usage: %s {get|set|commit|export|load|save}\n", argv[0]);
+    printf("usage: %s {get|set|commit|export|load|save|bench"
+#if IS_ACTIVE(CONFIG_REGISTRY_STATS)
+           "|stats"
+#endif /* CONFIG_REGISTRY_STATS */
+#if IS_ACTIVE(CONFIG_REGISTRY_TRACE)
+           "|trace"
+#endif /* CONFIG_REGISTRY_TRACE */
+           "}\n", argv[0]);
 
     return 1;
 }
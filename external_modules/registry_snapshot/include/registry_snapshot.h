@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2023 HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_registry_snapshot RIOT Registry Snapshot
+ * @ingroup     sys
+ * @brief       RIOT Registry module to export and import the registry as a compact CBOR stream
+ *
+ * A snapshot is a CBOR sequence of records. Every record is an array of the
+ * numeric ids of the path of a parameter followed by its value:
+ * `[namespace_id, schema_id, instance_id, id_0, ..., id_n, value]`.
+ * Snapshots are written and read in chunks through a fixed size buffer of
+ * @ref CONFIG_REGISTRY_SNAPSHOT_BUF_SIZE bytes, so the whole image never has
+ * to be in memory at once.
+ * @{
+ *
+ * @file
+ *
+ * @author      Lasse Rosenow <lasse.rosenow@haw-hamburg.de>
+ */
+
+#ifndef REGISTRY_SNAPSHOT_H
+#define REGISTRY_SNAPSHOT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "registry.h"
+
+/**
+ * @brief Size of the buffer that snapshots are streamed through. Every record must fit into it.
+ */
+#ifndef CONFIG_REGISTRY_SNAPSHOT_BUF_SIZE
+#define CONFIG_REGISTRY_SNAPSHOT_BUF_SIZE 128
+#endif
+
+/**
+ * @brief Prototype of a callback function that receives the next chunk of a snapshot.
+ *
+ * @param[in] buf Buffer containing the chunk
+ * @param[in] len Length of the chunk
+ * @param[in] arg Argument passed to @ref registry_snapshot_write()
+ * @return 0 on success, non-zero on failure
+ */
+typedef int (*registry_snapshot_write_cb_t)(const void *buf, const size_t len, void *arg);
+
+/**
+ * @brief Prototype of a callback function that provides the next chunk of a snapshot.
+ *
+ * @param[out] buf Buffer to fill with the chunk
+ * @param[in] len Maximum length of the chunk
+ * @param[in] arg Argument passed to @ref registry_snapshot_read()
+ * @return Length of the chunk, 0 at the end of the snapshot or a negative value on failure
+ */
+typedef int (*registry_snapshot_read_cb_t)(void *buf, const size_t len, void *arg);
+
+/**
+ * @brief Writes a snapshot of all configuration parameters included in @p path.
+ *
+ * @param[in] path Path of the configuration parameters
+ * @param[in] write_cb Callback function that is called for every chunk of the snapshot
+ * @param[in] arg Argument passed to @p write_cb
+ * @return 0 on success, -ENOBUFS if a record does not fit into
+ * @ref CONFIG_REGISTRY_SNAPSHOT_BUF_SIZE, other non-zero values on failure
+ */
+int registry_snapshot_write(const registry_path_t path, const registry_snapshot_write_cb_t write_cb,
+                            void *arg);
+
+/**
+ * @brief Reads a snapshot and sets all configuration parameters that it contains.
+ * Consecutive records of the same instance share a single lookup of the instance.
+ *
+ * @param[in] read_cb Callback function that is called to get the next chunk of the snapshot
+ * @param[in] arg Argument passed to @p read_cb
+ * @return 0 on success, -ENOBUFS if a record does not fit into
+ * @ref CONFIG_REGISTRY_SNAPSHOT_BUF_SIZE, -EINVAL if the snapshot is malformed or a
+ * parameter could not be set
+ */
+int registry_snapshot_read(const registry_snapshot_read_cb_t read_cb, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+#endif /* REGISTRY_SNAPSHOT_H */
@@ -0,0 +1,342 @@
+/*
+ * Copyright (C) 2023 HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_registry_snapshot RIOT Registry Snapshot
+ * @ingroup     sys
+ * @brief       RIOT Registry module to export and import the registry as a compact CBOR stream
+ * @{
+ *
+ * @file
+ *
+ * @author      Lasse Rosenow <lasse.rosenow@haw-hamburg.de>
+ */
+
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <kernel_defines.h>
+#define ENABLE_DEBUG (0)
+#include <debug.h>
+
+#include "nanocbor/nanocbor.h"
+#include "registry_snapshot.h"
+
+/* namespace_id, schema_id, instance_id and value */
+#define _RECORD_MIN_ITEMS 4
+
+typedef struct {
+    uint8_t buf[CONFIG_REGISTRY_SNAPSHOT_BUF_SIZE];
+    size_t buf_len;
+    registry_snapshot_write_cb_t write_cb;
+    void *arg;
+    int res;
+} _registry_snapshot_writer_t;
+
+static int _encode_value(nanocbor_encoder_t *enc, const registry_value_t *value)
+{
+    switch (value->type) {
+    case REGISTRY_TYPE_NONE: return nanocbor_fmt_null(enc);
+    case REGISTRY_TYPE_OPAQUE: return nanocbor_put_bstr(enc, value->buf, value->buf_len);
+    case REGISTRY_TYPE_STRING: return nanocbor_put_tstr(enc, value->buf);
+    case REGISTRY_TYPE_BOOL: return nanocbor_fmt_bool(enc, *(bool *)value->buf);
+
+    case REGISTRY_TYPE_UINT8: return nanocbor_fmt_uint(enc, *(uint8_t *)value->buf);
+    case REGISTRY_TYPE_UINT16: return nanocbor_fmt_uint(enc, *(uint16_t *)value->buf);
+    case REGISTRY_TYPE_UINT32: return nanocbor_fmt_uint(enc, *(uint32_t *)value->buf);
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_UINT64)
+    case REGISTRY_TYPE_UINT64: return nanocbor_fmt_uint(enc, *(uint64_t *)value->buf);
+#endif /* CONFIG_REGISTRY_USE_UINT64 */
+
+    case REGISTRY_TYPE_INT8: return nanocbor_fmt_int(enc, *(int8_t *)value->buf);
+    case REGISTRY_TYPE_INT16: return nanocbor_fmt_int(enc, *(int16_t *)value->buf);
+    case REGISTRY_TYPE_INT32: return nanocbor_fmt_int(enc, *(int32_t *)value->buf);
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_INT64)
+    case REGISTRY_TYPE_INT64: return nanocbor_fmt_int(enc, *(int64_t *)value->buf);
+#endif /* CONFIG_REGISTRY_USE_INT64 */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT32)
+    case REGISTRY_TYPE_FLOAT32: return nanocbor_fmt_float(enc, *(float *)value->buf);
+#endif /* CONFIG_REGISTRY_USE_FLOAT32 */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT64)
+    case REGISTRY_TYPE_FLOAT64: return nanocbor_fmt_double(enc, *(double *)value->buf);
+#endif /* CONFIG_REGISTRY_USE_FLOAT64 */
+    }
+
+    return -EINVAL;
+}
+
+static size_t _encode_record(uint8_t *buf, const size_t buf_len, const registry_path_t path,
+                             const registry_value_t *value)
+{
+    nanocbor_encoder_t enc;
+
+    nanocbor_encoder_init(&enc, buf, buf_len);
+
+    nanocbor_fmt_array(&enc, _RECORD_MIN_ITEMS + path.path_len);
+    nanocbor_fmt_uint(&enc, *path.namespace_id);
+    nanocbor_fmt_uint(&enc, *path.schema_id);
+    nanocbor_fmt_uint(&enc, *path.instance_id);
+
+    for (size_t i = 0; i < path.path_len; i++) {
+        nanocbor_fmt_uint(&enc, path.path[i]);
+    }
+
+    _encode_value(&enc, value);
+
+    /* nanocbor keeps counting if the buffer is too small, so this is the length the record needs */
+    return nanocbor_encoded_len(&enc);
+}
+
+static int _registry_snapshot_flush(_registry_snapshot_writer_t *writer)
+{
+    if (writer->buf_len > 0) {
+        int res = writer->write_cb(writer->buf, writer->buf_len, writer->arg);
+
+        if (res != 0) {
+            return res;
+        }
+
+        writer->buf_len = 0;
+    }
+
+    return 0;
+}
+
+static int _registry_snapshot_export_func(const registry_path_t path,
+                                          const registry_schema_t *schema,
+                                          const registry_instance_t *instance,
+                                          const registry_schema_item_t *meta,
+                                          const registry_value_t *value,
+                                          const void *context)
+{
+    (void)schema;
+    (void)instance;
+    (void)meta;
+
+    _registry_snapshot_writer_t *writer = (_registry_snapshot_writer_t *)context;
+
+    /* only parameters are part of the snapshot, the tree structure is implied by their paths */
+    if (value == NULL || writer->res != 0) {
+        return 0;
+    }
+
+    size_t free_len = sizeof(writer->buf) - writer->buf_len;
+    size_t record_len = _encode_record(&writer->buf[writer->buf_len], free_len, path, value);
+
+    if (record_len > free_len) {
+        /* the record does not fit behind the previous ones => flush them and encode it again */
+        writer->res = _registry_snapshot_flush(writer);
+
+        if (writer->res != 0) {
+            return writer->res;
+        }
+
+        if (record_len > sizeof(writer->buf)) {
+            writer->res = -ENOBUFS;
+            return writer->res;
+        }
+
+        _encode_record(writer->buf, sizeof(writer->buf), path, value);
+    }
+
+    writer->buf_len += record_len;
+
+    return 0;
+}
+
+int registry_snapshot_write(const registry_path_t path, const registry_snapshot_write_cb_t write_cb,
+                            void *arg)
+{
+    assert(write_cb != NULL);
+
+    _registry_snapshot_writer_t writer = {
+        .buf_len = 0,
+        .write_cb = write_cb,
+        .arg = arg,
+        .res = 0,
+    };
+
+    int res = registry_export(_registry_snapshot_export_func, path, 0, &writer);
+
+    if (writer.res != 0) {
+        return writer.res;
+    }
+
+    if (res != 0) {
+        return res;
+    }
+
+    return _registry_snapshot_flush(&writer);
+}
+
+/* Implementation of registry_value_decode_cb_t, arg is the decoder of the record */
+static int _decode_value(const registry_type_t type, void *buf, const size_t buf_len, void *arg)
+{
+    nanocbor_value_t *dec = arg;
+    const uint8_t *str;
+    size_t str_len;
+    int res = -EINVAL;
+
+    switch (type) {
+    case REGISTRY_TYPE_NONE: break;
+    case REGISTRY_TYPE_OPAQUE:
+        res = nanocbor_get_bstr(dec, &str, &str_len);
+        if (res >= 0 && str_len <= buf_len) {
+            memcpy(buf, str, str_len);
+        }
+        else {
+            res = -EINVAL;
+        }
+        break;
+    case REGISTRY_TYPE_STRING:
+        /* the string in the registry must keep its null terminator */
+        res = nanocbor_get_tstr(dec, &str, &str_len);
+        if (res >= 0 && str_len < buf_len) {
+            memcpy(buf, str, str_len);
+        }
+        else {
+            res = -EINVAL;
+        }
+        break;
+    case REGISTRY_TYPE_BOOL: res = nanocbor_get_bool(dec, buf); break;
+
+    case REGISTRY_TYPE_UINT8: res = nanocbor_get_uint8(dec, buf); break;
+    case REGISTRY_TYPE_UINT16: res = nanocbor_get_uint16(dec, buf); break;
+    case REGISTRY_TYPE_UINT32: res = nanocbor_get_uint32(dec, buf); break;
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_UINT64)
+    case REGISTRY_TYPE_UINT64: res = nanocbor_get_uint64(dec, buf); break;
+#endif /* CONFIG_REGISTRY_USE_UINT64 */
+
+    case REGISTRY_TYPE_INT8: res = nanocbor_get_int8(dec, buf); break;
+    case REGISTRY_TYPE_INT16: res = nanocbor_get_int16(dec, buf); break;
+    case REGISTRY_TYPE_INT32: res = nanocbor_get_int32(dec, buf); break;
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_INT64)
+    case REGISTRY_TYPE_INT64: res = nanocbor_get_int64(dec, buf); break;
+#endif /* CONFIG_REGISTRY_USE_INT64 */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT32)
+    case REGISTRY_TYPE_FLOAT32: res = nanocbor_get_float(dec, buf); break;
+#endif /* CONFIG_REGISTRY_USE_FLOAT32 */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_USE_FLOAT64)
+    case REGISTRY_TYPE_FLOAT64: res = nanocbor_get_double(dec, buf); break;
+#endif /* CONFIG_REGISTRY_USE_FLOAT64 */
+    }
+
+    return res < 0 ? -EINVAL : 0;
+}
+
+static int _decode_record(nanocbor_value_t *dec, registry_lookup_cache_t *cache)
+{
+    nanocbor_value_t record;
+    uint32_t namespace_id;
+    registry_id_t schema_id;
+    registry_id_t instance_id;
+    registry_id_t ids[REGISTRY_MAX_DIR_DEPTH];
+
+    if (nanocbor_enter_array(dec, &record) < 0) {
+        return -EINVAL;
+    }
+
+    uint32_t items = nanocbor_array_items_remaining(&record);
+
+    if (items < _RECORD_MIN_ITEMS || items - _RECORD_MIN_ITEMS > ARRAY_SIZE(ids)) {
+        return -EINVAL;
+    }
+
+    size_t path_len = items - _RECORD_MIN_ITEMS;
+
+    if (nanocbor_get_uint32(&record, &namespace_id) < 0 ||
+        nanocbor_get_uint32(&record, &schema_id) < 0 ||
+        nanocbor_get_uint32(&record, &instance_id) < 0) {
+        return -EINVAL;
+    }
+
+    for (size_t i = 0; i < path_len; i++) {
+        if (nanocbor_get_uint32(&record, &ids[i]) < 0) {
+            return -EINVAL;
+        }
+    }
+
+    registry_namespace_id_t _namespace_id = namespace_id;
+    registry_path_t path = {
+        .namespace_id = &_namespace_id,
+        .schema_id = &schema_id,
+        .instance_id = &instance_id,
+        .path = ids,
+        .path_len = path_len,
+    };
+
+    /* the value is decoded as the type of the parameter, during the lookup of the set */
+    return registry_set_value_decoded(cache, path, _decode_value, &record);
+}
+
+int registry_snapshot_read(const registry_snapshot_read_cb_t read_cb, void *arg)
+{
+    assert(read_cb != NULL);
+
+    uint8_t buf[CONFIG_REGISTRY_SNAPSHOT_BUF_SIZE];
+    size_t buf_len = 0;
+    bool end = false;
+    registry_lookup_cache_t cache = { 0 };
+    int rc = 0;
+
+    while (true) {
+        if (!end && buf_len < sizeof(buf)) {
+            int len = read_cb(&buf[buf_len], sizeof(buf) - buf_len, arg);
+
+            if (len < 0) {
+                return len;
+            }
+
+            end = len == 0;
+            buf_len += len;
+        }
+
+        if (buf_len == 0 && end) {
+            break;
+        }
+
+        /* only decode the next record once it is completely inside of the buffer */
+        nanocbor_value_t dec;
+        nanocbor_decoder_init(&dec, buf, buf_len);
+
+        nanocbor_value_t probe = dec;
+
+        if (nanocbor_skip(&probe) < 0) {
+            if (end) {
+                return -EINVAL;
+            }
+
+            if (buf_len == sizeof(buf)) {
+                return -ENOBUFS;
+            }
+
+            continue;
+        }
+
+        size_t record_len = probe.cur - buf;
+        int res = _decode_record(&dec, &cache);
+
+        if (res != 0) {
+            DEBUG("[registry_snapshot] Failed to apply record: %d\n", res);
+            if (rc == 0) {
+                rc = res;
+            }
+        }
+
+        memmove(buf, &buf[record_len], buf_len - record_len);
+        buf_len -= record_len;
+    }
+
+    return rc;
+}
+
+/** @} */
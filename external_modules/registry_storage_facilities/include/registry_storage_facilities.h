@@ -26,9 +26,108 @@ extern "C" {
 
 #include "registry.h"
 
-/* heap dummy */
-#if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP_DUMMY) || IS_ACTIVE(DOXYGEN)
-extern registry_storage_facility_t registry_storage_facility_heap_dummy;
+/* heap */
+#if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP) || IS_ACTIVE(DOXYGEN)
+/**
+ * @brief Maximum amount of parameters a heap storage facility instance can hold.
+ */
+#ifndef CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_CAPACITY
+#define CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_CAPACITY 100
+#endif
+
+/**
+ * @brief Size of the hash index of a heap storage facility instance.
+ * Must be a power of two and bigger than @ref CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_CAPACITY.
+ */
+#ifndef CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_INDEX_SIZE
+#define CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_INDEX_SIZE 256
+#endif
+
+/**
+ * @brief Size in bytes of the arena that holds the values of a heap storage facility instance.
+ * Must not be bigger than UINT16_MAX, because the offsets inside of the arena are 16 bit.
+ */
+#ifndef CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_ARENA_SIZE
+#define CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_ARENA_SIZE 2048
+#endif
+
+/**
+ * @brief Parameter stored inside of a heap storage facility instance.
+ */
+typedef struct {
+    registry_path_packed_t path;                /**< Path of the parameter */
+    registry_type_t type;                       /**< Type of the stored value */
+    uint16_t buf_offset;                        /**< Offset of the value inside of the arena */
+    uint16_t buf_len;                           /**< Length of the stored value */
+    uint16_t buf_size;                          /**< Size of the chunk reserved in the arena */
+    uint32_t hash;                              /**< Hash of the stored value */
+} registry_storage_facility_heap_entry_t;
+
+/**
+ * @brief Data of a heap storage facility instance. It needs to be passed as data
+ * to the @ref registry_storage_facility_instance_t and must be zero initialized.
+ */
+typedef struct {
+    /** Stored parameters in the order they were saved for the first time */
+    registry_storage_facility_heap_entry_t entries[CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_CAPACITY];
+    /** Hash index of the full paths, containing the entry position + 1 or 0 if empty */
+    uint16_t index[CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_INDEX_SIZE];
+    /** Buffer containing the values of all entries */
+    uint8_t arena[CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_ARENA_SIZE] __attribute__((aligned(8)));
+    uint16_t entries_len;   /**< Amount of used entries */
+    uint16_t arena_used;    /**< Amount of used bytes of the arena */
+} registry_storage_facility_heap_t;
+
+extern registry_storage_facility_t registry_storage_facility_heap;
+#endif
+
+/* tiered */
+#if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_TIERED) || IS_ACTIVE(DOXYGEN)
+/**
+ * @brief Policy of a tiered storage facility instance, which defines when values reach the slow tier.
+ */
+typedef enum {
+    /** Values are saved to the fast and the slow tier at the same time */
+    REGISTRY_STORAGE_FACILITY_TIERED_WRITE_THROUGH,
+    /** Values are only saved to the fast tier, until @ref registry_storage_facility_tiered_flush() is called */
+    REGISTRY_STORAGE_FACILITY_TIERED_WRITE_BACK,
+} registry_storage_facility_tiered_policy_t;
+
+/**
+ * @brief Data of a tiered storage facility instance. It needs to be passed as data
+ * to the @ref registry_storage_facility_instance_t.
+ *
+ * The fast tier (e.g. a heap storage facility) serves all loads and is warmed up
+ * from the slow tier (e.g. a VFS storage facility) before it is used for the first time.
+ * The fast tier must be big enough to hold all parameters of the slow tier.
+ */
+typedef struct {
+    const registry_storage_facility_instance_t *fast;   /**< Fast storage facility (RAM) */
+    const registry_storage_facility_instance_t *slow;   /**< Slow storage facility (VFS, MTD etc.) */
+    registry_storage_facility_tiered_policy_t policy;   /**< Write policy */
+    bool warm;      /**< Internal: true if the fast tier contains all parameters of the slow tier */
+    bool dirty;     /**< Internal: true if the fast tier may contain values that are not in the slow tier */
+} registry_storage_facility_tiered_t;
+
+extern registry_storage_facility_t registry_storage_facility_tiered;
+
+/**
+ * @brief Copies all parameters of the slow tier into the fast tier. This is done
+ * automatically on first use, but can be called at boot to move the cost out of the first load.
+ *
+ * @param[in] instance Tiered storage facility instance
+ * @return 0 on success, non-zero on failure
+ */
+int registry_storage_facility_tiered_warm(const registry_storage_facility_instance_t *instance);
+
+/**
+ * @brief Writes all values of the fast tier, that differ from the slow tier, into the slow tier.
+ * Only needed for the @ref REGISTRY_STORAGE_FACILITY_TIERED_WRITE_BACK policy.
+ *
+ * @param[in] instance Tiered storage facility instance
+ * @return 0 on success, non-zero on failure
+ */
+int registry_storage_facility_tiered_flush(const registry_storage_facility_instance_t *instance);
 #endif
 
 /* vfs */
@@ -36,5 +135,50 @@ extern registry_storage_facility_t registry_storage_facility_heap_dummy;
 extern registry_storage_facility_t registry_storage_facility_vfs;
 #endif
 
+/* vfs a/b */
+#if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_VFS_AB) || IS_ACTIVE(DOXYGEN)
+#include "vfs.h"
+
+/**
+ * @brief Amount of parameters whose paths are kept in RAM during a single @ref registry_save()
+ * call, so that their old values are not copied from the active slot. The paths of further
+ * parameters are looked up in the written slot instead, which is slower, but has no limit.
+ */
+#ifndef CONFIG_REGISTRY_STORAGE_FACILITY_VFS_AB_SAVED_INDEX_SIZE
+#define CONFIG_REGISTRY_STORAGE_FACILITY_VFS_AB_SAVED_INDEX_SIZE 16
+#endif
+
+/**
+ * @brief Data of a VFS A/B storage facility instance. It needs to be passed as data
+ * to the @ref registry_storage_facility_instance_t.
+ *
+ * All parameters are stored inside of one of two slot files, each starting with a header that
+ * contains a sequence number and the CRC32 of the slot. A save writes all saved parameters,
+ * followed by the unchanged parameters of the active slot, into the inactive slot and only
+ * then writes its header. So a save that is interrupted by a power failure leaves the
+ * previously active slot untouched, and a load only has to check the two headers to find
+ * the slot with the newest complete configuration. The CRC32 of a slot is only checked by the
+ * first load after boot, slots written by a save are known to be valid.
+ */
+typedef struct {
+    vfs_mount_t *mount;     /**< VFS mount point that contains both slots */
+    uint32_t seq;           /**< Internal: sequence number of the active slot, 0 if no slot is valid */
+    uint8_t active;         /**< Internal: index of the active slot */
+    uint32_t verified_seq;  /**< Internal: sequence number of the slot whose CRC was checked */
+    int fd;                 /**< Internal: file descriptor of the slot that is currently written */
+    uint32_t len;           /**< Internal: length of the parameters written to the slot so far */
+    uint32_t crc;           /**< Internal: CRC32 of the parameters written to the slot so far */
+    int res;                /**< Internal: first error that occurred during the current save */
+    bool mounted;           /**< Internal: the current save mounted the mount point */
+    /** Internal: sorted paths of the parameters that were written during the current save */
+    registry_path_packed_t saved[CONFIG_REGISTRY_STORAGE_FACILITY_VFS_AB_SAVED_INDEX_SIZE];
+    size_t saved_len;       /**< Internal: amount of used entries of saved */
+    bool saved_overflow;    /**< Internal: not all written parameters are contained in saved */
+    uint32_t saved_records_len; /**< Internal: length of the parameters written by save */
+} registry_storage_facility_vfs_ab_t;
+
+extern registry_storage_facility_t registry_storage_facility_vfs_ab;
+#endif
+
 /** @} */
 #endif /* REGISTRY_STORAGE_FACILITIES_H */
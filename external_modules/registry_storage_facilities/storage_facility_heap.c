@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2023 HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_registry_cli RIOT Registry Storage Facilities: Heap
+ * @ingroup     sys
+ * @brief       RIOT Registry Heap Storage Facility, keeps parameters in RAM. It can be used as a fast cache or for testing.
+ * @{
+ *
+ * @file
+ *
+ * @author      Lasse Rosenow <lasse.rosenow@haw-hamburg.de>
+ */
+
+#include "registry_storage_facilities.h"
+#include "registry_path.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <kernel_defines.h>
+#include "errno.h"
+
+#if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP) || IS_ACTIVE(DOXYGEN)
+
+#define INDEX_MASK (CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_INDEX_SIZE - 1)
+
+static_assert((CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_INDEX_SIZE & INDEX_MASK) == 0,
+              "CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_INDEX_SIZE must be a power of two");
+static_assert(CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_INDEX_SIZE >
+              CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_CAPACITY,
+              "CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_INDEX_SIZE must be bigger than the capacity");
+static_assert(CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_CAPACITY < UINT16_MAX,
+              "CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_CAPACITY must fit into the uint16_t index");
+static_assert(CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_ARENA_SIZE <= UINT16_MAX,
+              "CONFIG_REGISTRY_STORAGE_FACILITY_HEAP_ARENA_SIZE must fit into the uint16_t offsets");
+
+/* The storage_facility argument is the descriptor of the storage facility */
+static int load(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                const load_cb_t cb, const void *cb_arg);
+static int save(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                const registry_value_t value);
+static int hash(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                uint32_t *hash);
+
+/* Storage Facility interface descriptor to be registered in the RIOT
+   Registry */
+registry_storage_facility_t registry_storage_facility_heap = {
+    .load = load,
+    .save = save,
+    .hash = hash,
+};
+
+static uint32_t _path_hash(const registry_path_packed_t *path)
+{
+    registry_value_t value = {
+        .type = REGISTRY_TYPE_OPAQUE,
+        .buf = path->ids,
+        .buf_len = path->ids_len * sizeof(path->ids[0]),
+    };
+
+    return registry_value_hash(&value);
+}
+
+/* Returns the slot of the hash index that either points to the entry of the path or is empty */
+static uint16_t *_index_lookup(registry_storage_facility_heap_t *heap,
+                               const registry_path_packed_t *path)
+{
+    size_t i = _path_hash(path) & INDEX_MASK;
+
+    /* there is always at least one empty slot, because the index is bigger than the capacity */
+    while (heap->index[i] != 0) {
+        if (registry_path_packed_equal(&heap->entries[heap->index[i] - 1].path, path)) {
+            break;
+        }
+
+        i = (i + 1) & INDEX_MASK;
+    }
+
+    return &heap->index[i];
+}
+
+/* Reserves a chunk inside of the arena, which is aligned according to its size */
+static int _arena_alloc(registry_storage_facility_heap_t *heap, const size_t size)
+{
+    size_t align = 1;
+
+    while (align < 8 && align * 2 <= size) {
+        align *= 2;
+    }
+
+    size_t offset = (heap->arena_used + align - 1) & ~(align - 1);
+
+    if (offset + size > sizeof(heap->arena)) {
+        return -ENOMEM;
+    }
+
+    heap->arena_used = offset + size;
+
+    return offset;
+}
+
+/* Implementation of `load`. Execute a `cb` callback for each configuration
+   found in the heap that is located inside of the given path */
+static int load(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                const load_cb_t cb, const void *cb_arg)
+{
+    registry_storage_facility_heap_t *heap = instance->data;
+
+    for (size_t i = 0; i < heap->entries_len; i++) {
+        registry_storage_facility_heap_entry_t *entry = &heap->entries[i];
+        registry_id_t ids[REGISTRY_MAX_DIR_DEPTH + 3];
+        registry_path_t entry_path;
+
+        registry_path_unpack(&entry->path, ids, &entry_path);
+
+        if (!registry_path_is_prefix(path, entry_path)) {
+            continue;
+        }
+
+        registry_value_t value = {
+            .type = entry->type,
+            .buf = &heap->arena[entry->buf_offset],
+            .buf_len = entry->buf_len,
+        };
+
+        cb(entry_path, value, cb_arg);
+    }
+
+    return 0;
+}
+
+/* Implementation of `save`. Save parameter with given path and value in the heap */
+static int save(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                const registry_value_t value)
+{
+    registry_storage_facility_heap_t *heap = instance->data;
+
+    if (path.namespace_id == NULL || path.schema_id == NULL || path.instance_id == NULL) {
+        return -EINVAL;
+    }
+
+    registry_path_packed_t packed_path;
+
+    if (path.path_len == 0 || registry_path_pack(path, &packed_path) < 0) {
+        return -EINVAL;
+    }
+
+    uint16_t *index_slot = _index_lookup(heap, &packed_path);
+    registry_storage_facility_heap_entry_t *entry;
+
+    if (*index_slot != 0) {
+        entry = &heap->entries[*index_slot - 1];
+    }
+    else {
+        if (heap->entries_len >= ARRAY_SIZE(heap->entries)) {
+            return -ENOMEM;
+        }
+
+        entry = &heap->entries[heap->entries_len];
+        entry->path = packed_path;
+        entry->buf_size = 0;
+    }
+
+    /* values of a parameter normally keep their size, so the arena is never compacted and a new
+       chunk is only reserved if the value does not fit into the old one anymore */
+    if (value.buf_len > entry->buf_size) {
+        int offset = _arena_alloc(heap, value.buf_len);
+
+        if (offset < 0) {
+            return offset;
+        }
+
+        entry->buf_offset = offset;
+        entry->buf_size = value.buf_len;
+    }
+
+    memcpy(&heap->arena[entry->buf_offset], value.buf, value.buf_len);
+    entry->buf_len = value.buf_len;
+    entry->type = value.type;
+    entry->hash = registry_value_hash(&value);
+
+    if (*index_slot == 0) {
+        *index_slot = ++heap->entries_len;
+    }
+
+    return 0;
+}
+
+/* Implementation of `hash`. Return the hash of the value that was saved last for the given path */
+static int hash(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                uint32_t *hash)
+{
+    registry_storage_facility_heap_t *heap = instance->data;
+
+    if (path.namespace_id == NULL || path.schema_id == NULL || path.instance_id == NULL) {
+        return -EINVAL;
+    }
+
+    registry_path_packed_t packed_path;
+
+    if (path.path_len == 0 || registry_path_pack(path, &packed_path) < 0) {
+        return -ENOENT;
+    }
+
+    uint16_t *index_slot = _index_lookup(heap, &packed_path);
+
+    if (*index_slot == 0) {
+        return -ENOENT;
+    }
+
+    *hash = heap->entries[*index_slot - 1].hash;
+    return 0;
+}
+
+#endif
+
+/** @} */
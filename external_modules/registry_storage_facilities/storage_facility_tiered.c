@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2023 HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_registry_cli RIOT Registry Storage Facilities: Tiered
+ * @ingroup     sys
+ * @brief       RIOT Registry Tiered Storage Facility, puts a fast storage facility as a cache in front of a slow one.
+ * @{
+ *
+ * @file
+ *
+ * @author      Lasse Rosenow <lasse.rosenow@haw-hamburg.de>
+ */
+
+#include "registry_storage_facilities.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <kernel_defines.h>
+#include "errno.h"
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_TIERED) || IS_ACTIVE(DOXYGEN)
+
+static int load(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                const load_cb_t cb, const void *cb_arg);
+static int save_start(const registry_storage_facility_instance_t *instance);
+static int save(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                const registry_value_t value);
+static int save_end(const registry_storage_facility_instance_t *instance);
+static int hash(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                uint32_t *hash);
+
+registry_storage_facility_t registry_storage_facility_tiered = {
+    .load = load,
+    .save_start = save_start,
+    .save = save,
+    .save_end = save_end,
+    .hash = hash,
+};
+
+typedef struct {
+    const registry_storage_facility_instance_t *dst;
+    int res;
+} _copy_arg_t;
+
+static int _save_start(const registry_storage_facility_instance_t *instance)
+{
+    if (instance->itf->save_start) {
+        return instance->itf->save_start(instance);
+    }
+
+    return 0;
+}
+
+static int _save_end(const registry_storage_facility_instance_t *instance)
+{
+    if (instance->itf->save_end) {
+        return instance->itf->save_end(instance);
+    }
+
+    return 0;
+}
+
+/* Saves every loaded parameter into the destination tier, unless it already contains the same value */
+static void _copy_cb(const registry_path_t path, const registry_value_t value, const void *cb_arg)
+{
+    _copy_arg_t *copy = (_copy_arg_t *)cb_arg;
+    const registry_storage_facility_instance_t *dst = copy->dst;
+    uint32_t stored_hash;
+
+    if (dst->itf->hash && dst->itf->hash(dst, path, &stored_hash) == 0 &&
+        stored_hash == registry_value_hash(&value)) {
+        return;
+    }
+
+    int res = dst->itf->save(dst, path, value);
+
+    if (res != 0) {
+        DEBUG("[registry storage_facility_tiered] Can not copy parameter: %d\n", res);
+        copy->res = res;
+    }
+}
+
+static int _copy(const registry_storage_facility_instance_t *src,
+                 const registry_storage_facility_instance_t *dst)
+{
+    _copy_arg_t copy = {
+        .dst = dst,
+        .res = 0,
+    };
+
+    int res = _save_start(dst);
+
+    if (res != 0) {
+        return res;
+    }
+
+    res = src->itf->load(src, _REGISTRY_PATH_0(), _copy_cb, &copy);
+
+    /* the save must be finished even if loading failed */
+    int end_res = _save_end(dst);
+
+    if (res != 0) {
+        return res;
+    }
+
+    return copy.res != 0 ? copy.res : end_res;
+}
+
+int registry_storage_facility_tiered_warm(const registry_storage_facility_instance_t *instance)
+{
+    registry_storage_facility_tiered_t *tiered = instance->data;
+
+    if (tiered->warm) {
+        return 0;
+    }
+
+    int res = _copy(tiered->slow, tiered->fast);
+
+    if (res == 0) {
+        tiered->warm = true;
+    }
+
+    return res;
+}
+
+int registry_storage_facility_tiered_flush(const registry_storage_facility_instance_t *instance)
+{
+    registry_storage_facility_tiered_t *tiered = instance->data;
+
+    if (!tiered->dirty) {
+        return 0;
+    }
+
+    int res = _copy(tiered->fast, tiered->slow);
+
+    if (res == 0) {
+        tiered->dirty = false;
+    }
+
+    return res;
+}
+
+static int load(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                const load_cb_t cb, const void *cb_arg)
+{
+    registry_storage_facility_tiered_t *tiered = instance->data;
+
+    int res = registry_storage_facility_tiered_warm(instance);
+
+    if (res != 0) {
+        return res;
+    }
+
+    return tiered->fast->itf->load(tiered->fast, path, cb, cb_arg);
+}
+
+static int save_start(const registry_storage_facility_instance_t *instance)
+{
+    registry_storage_facility_tiered_t *tiered = instance->data;
+
+    /* the fast tier must contain all parameters, before it can be used to answer hash requests */
+    int res = registry_storage_facility_tiered_warm(instance);
+
+    if (res != 0) {
+        return res;
+    }
+
+    if (tiered->policy == REGISTRY_STORAGE_FACILITY_TIERED_WRITE_THROUGH) {
+        res = _save_start(tiered->slow);
+
+        if (res != 0) {
+            return res;
+        }
+    }
+
+    res = _save_start(tiered->fast);
+
+    /* registry_save does not call save_end after a failed save_start */
+    if (res != 0 && tiered->policy == REGISTRY_STORAGE_FACILITY_TIERED_WRITE_THROUGH) {
+        _save_end(tiered->slow);
+    }
+
+    return res;
+}
+
+static int save(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                const registry_value_t value)
+{
+    registry_storage_facility_tiered_t *tiered = instance->data;
+
+    /* the slow tier is written first, because the hashes of the fast tier decide which
+       parameters are saved. A value that only reached the fast tier would never be saved again */
+    if (tiered->policy == REGISTRY_STORAGE_FACILITY_TIERED_WRITE_THROUGH) {
+        int res = tiered->slow->itf->save(tiered->slow, path, value);
+
+        if (res != 0) {
+            return res;
+        }
+    }
+
+    int res = tiered->fast->itf->save(tiered->fast, path, value);
+
+    if (res != 0) {
+        return res;
+    }
+
+    if (tiered->policy != REGISTRY_STORAGE_FACILITY_TIERED_WRITE_THROUGH) {
+        tiered->dirty = true;
+    }
+
+    return 0;
+}
+
+static int save_end(const registry_storage_facility_instance_t *instance)
+{
+    registry_storage_facility_tiered_t *tiered = instance->data;
+    int res = 0;
+
+    /* e.g. the slow tier commits its slot in save_end, so its result must not get lost */
+    if (tiered->policy == REGISTRY_STORAGE_FACILITY_TIERED_WRITE_THROUGH) {
+        res = _save_end(tiered->slow);
+    }
+
+    int fast_res = _save_end(tiered->fast);
+
+    if (tiered->policy == REGISTRY_STORAGE_FACILITY_TIERED_WRITE_THROUGH) {
+        /* the fast tier already contains the new values, even though the slow tier did not
+           commit them. Its hashes are not used until a save succeeds, so all parameters are
+           saved again, and the next load warms it from the slow tier again */
+        if (res != 0) {
+            tiered->warm = false;
+            tiered->dirty = true;
+        }
+        else if (fast_res == 0) {
+            tiered->dirty = false;
+        }
+    }
+
+    return res != 0 ? res : fast_res;
+}
+
+static int hash(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                uint32_t *hash)
+{
+    registry_storage_facility_tiered_t *tiered = instance->data;
+
+    /* in write-through mode, dirty means the slow tier failed to commit the fast tier's values */
+    if (!tiered->warm || !tiered->fast->itf->hash ||
+        (tiered->dirty && tiered->policy == REGISTRY_STORAGE_FACILITY_TIERED_WRITE_THROUGH)) {
+        return -ENOENT;
+    }
+
+    return tiered->fast->itf->hash(tiered->fast, path, hash);
+}
+
+#endif
+
+/** @} */
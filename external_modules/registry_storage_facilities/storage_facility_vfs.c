@@ -18,6 +18,7 @@
  */
 
 #include "registry_storage_facilities.h"
+#include "registry_path.h"
 
 #include <stdlib.h>
 #include <ctype.h>
@@ -33,16 +34,50 @@
 
 #if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_VFS) || IS_ACTIVE(DOXYGEN)
 
+/**
+ * @brief Maximum amount of parameters whose value hash is kept in the hash index.
+ * Parameters that do not fit into the index are always written on save.
+ * Each entry stores the whole packed path of its parameter, which costs about 28 bytes of RAM.
+ */
+#ifndef CONFIG_REGISTRY_STORAGE_FACILITY_VFS_HASH_INDEX_SIZE
+#define CONFIG_REGISTRY_STORAGE_FACILITY_VFS_HASH_INDEX_SIZE 32
+#endif
+
+/* File inside the mount point that persists the hash index. Its name is not a valid registry path,
+   so it is ignored by load */
+#define HASH_INDEX_FILE_NAME "/.hash_index"
+
+/* First word of the hash index file, files of other layouts are ignored */
+#define HASH_INDEX_MAGIC 0x52484902 /* "RHI" + version 2 */
+
 static int load(const registry_storage_facility_instance_t *instance, const registry_path_t path,
                 const load_cb_t cb, const void *cb_arg);
+static int save_start(const registry_storage_facility_instance_t *instance);
 static int save(const registry_storage_facility_instance_t *instance, const registry_path_t path,
                 const registry_value_t value);
+static int save_end(const registry_storage_facility_instance_t *instance);
+static int hash(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                uint32_t *hash);
 
 registry_storage_facility_t registry_storage_facility_vfs = {
     .load = load,
+    .save_start = save_start,
     .save = save,
+    .save_end = save_end,
+    .hash = hash,
 };
 
+typedef struct {
+    registry_path_packed_t path;    /* path of the parameter */
+    uint32_t value_hash;            /* CRC32 of the stored value of the parameter */
+} hash_index_entry_t;
+
+/* The hash index is only valid between save_start and save_end of the mount it was read from */
+static hash_index_entry_t _hash_index[CONFIG_REGISTRY_STORAGE_FACILITY_VFS_HASH_INDEX_SIZE];
+static size_t _hash_index_len;
+static bool _hash_index_dirty;
+static const vfs_mount_t *_hash_index_mount;
+
 static void _string_path_append_item(char *dest, registry_id_t number)
 {
     int size = snprintf(NULL, 0, "/%d", number);
@@ -132,6 +167,62 @@ static int _umount(vfs_mount_t *mount)
     return 0;
 }
 
+static hash_index_entry_t *_hash_index_lookup(const registry_path_packed_t *path)
+{
+    for (size_t i = 0; i < _hash_index_len; i++) {
+        if (registry_path_packed_equal(&_hash_index[i].path, path)) {
+            return &_hash_index[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void _hash_index_update(const registry_path_t path, const registry_value_t value)
+{
+    registry_path_packed_t packed;
+
+    if (registry_path_pack(path, &packed) != 0) {
+        /* the ids are too big for the index => the parameter will just always be written */
+        return;
+    }
+
+    hash_index_entry_t *entry = _hash_index_lookup(&packed);
+
+    if (entry == NULL) {
+        if (_hash_index_len >= ARRAY_SIZE(_hash_index)) {
+            /* index is full => the parameter will just always be written */
+            return;
+        }
+
+        entry = &_hash_index[_hash_index_len++];
+        entry->path = packed;
+    }
+
+    entry->value_hash = registry_value_hash(&value);
+}
+
+/* Forgets the stored value of a parameter, e.g. because writing it failed */
+static void _hash_index_remove(const registry_path_t path)
+{
+    registry_path_packed_t packed;
+
+    if (registry_path_pack(path, &packed) != 0) {
+        return;
+    }
+
+    hash_index_entry_t *entry = _hash_index_lookup(&packed);
+
+    if (entry != NULL) {
+        *entry = _hash_index[--_hash_index_len];
+    }
+}
+
+static void _hash_index_path(const vfs_mount_t *mount, char *string_path)
+{
+    sprintf(string_path, "%s%s", mount->mount_point, HASH_INDEX_FILE_NAME);
+}
+
 static int load(const registry_storage_facility_instance_t *instance, const registry_path_t path,
                 const load_cb_t cb, const void *cb_arg)
 {
@@ -259,11 +350,17 @@ static int load(const registry_storage_facility_instance_t *instance, const regi
 
                                     /* get registry meta data of configuration parameter */
                                     registry_value_t value;
-                                    registry_get_value(path, &value);
+
+                                    if (registry_load_expected_value(path, &value) < 0) {
+                                        DEBUG(
+                                            "[registry storage_facility_vfs] load: Unknown parameter\n");
+                                        value.buf_len = 0;
+                                    }
 
                                     /* read value from file */
-                                    uint8_t new_value_buf[value.buf_len];
-                                    if (vfs_read(fd, new_value_buf, value.buf_len) < 0) {
+                                    uint8_t new_value_buf[value.buf_len > 0 ? value.buf_len : 1];
+                                    if (value.buf_len == 0 ||
+                                        vfs_read(fd, new_value_buf, value.buf_len) < 0) {
                                         DEBUG(
                                             "[registry storage_facility_vfs] load: Can not read from file\n");
                                     }
@@ -326,16 +423,140 @@ static int load(const registry_storage_facility_instance_t *instance, const regi
     return 0;
 }
 
+static int save_start(const registry_storage_facility_instance_t *instance)
+{
+    vfs_mount_t *mount = instance->data;
+
+    _hash_index_len = 0;
+    _hash_index_dirty = false;
+    _hash_index_mount = NULL;
+
+    /* mount */
+    if (_mount(mount) != 0) {
+        return -EIO;
+    }
+
+    _hash_index_mount = mount;
+
+    /* read the persisted hash index */
+    char string_path[REGISTRY_MAX_DIR_LEN];
+
+    _hash_index_path(mount, string_path);
+
+    int fd = vfs_open(string_path, O_RDONLY, 0);
+
+    if (fd >= 0) {
+        uint32_t magic = 0;
+
+        if (vfs_read(fd, &magic, sizeof(magic)) == sizeof(magic) && magic == HASH_INDEX_MAGIC) {
+            int res = vfs_read(fd, _hash_index, sizeof(_hash_index));
+
+            if (res > 0) {
+                _hash_index_len = res / sizeof(hash_index_entry_t);
+            }
+        }
+
+        if (vfs_close(fd) != 0) {
+            DEBUG("[registry storage_facility_vfs] save_start: Can not close file: %d\n", fd);
+        }
+    }
+
+    /* umount */
+    _umount(mount);
+
+    return 0;
+}
+
+static int save_end(const registry_storage_facility_instance_t *instance)
+{
+    vfs_mount_t *mount = instance->data;
+    int res = 0;
+
+    _hash_index_mount = NULL;
+
+    if (!_hash_index_dirty) {
+        return 0;
+    }
+
+    /* mount */
+    if (_mount(mount) != 0) {
+        return -EIO;
+    }
+
+    /* persist the updated hash index */
+    char string_path[REGISTRY_MAX_DIR_LEN];
+
+    _hash_index_path(mount, string_path);
+
+    int fd = vfs_open(string_path, O_CREAT | O_WRONLY | O_TRUNC, 0);
+
+    if (fd < 0) {
+        DEBUG("[registry storage_facility_vfs] save_end: Can not open file: %d\n", fd);
+        res = fd;
+    }
+    else {
+        const uint32_t magic = HASH_INDEX_MAGIC;
+
+        if (vfs_write(fd, &magic, sizeof(magic)) < 0 ||
+            vfs_write(fd, _hash_index, _hash_index_len * sizeof(hash_index_entry_t)) < 0) {
+            DEBUG("[registry storage_facility_vfs] save_end: Can not write to file: %d\n", fd);
+            res = -EIO;
+        }
+
+        if (vfs_close(fd) != 0) {
+            DEBUG("[registry storage_facility_vfs] save_end: Can not close file: %d\n", fd);
+            res = -EIO;
+        }
+    }
+
+    /* umount */
+    _umount(mount);
+
+    return res;
+}
+
+static int hash(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                uint32_t *hash)
+{
+    if (_hash_index_mount != instance->data) {
+        return -ENOENT;
+    }
+
+    registry_path_packed_t packed;
+
+    if (registry_path_pack(path, &packed) != 0) {
+        return -ENOENT;
+    }
+
+    hash_index_entry_t *entry = _hash_index_lookup(&packed);
+
+    if (entry == NULL) {
+        return -ENOENT;
+    }
+
+    *hash = entry->value_hash;
+    return 0;
+}
+
 static int save(const registry_storage_facility_instance_t *instance, const registry_path_t path,
                 const registry_value_t value)
 {
-    (void)path;
-    (void)value;
-
     vfs_mount_t *mount = instance->data;
 
     /* mount */
-    _mount(mount);
+    if (_mount(mount) != 0) {
+        return -EIO;
+    }
+
+    /* remove the persisted hash index before the first write, so that an interrupted save
+       can not leave behind an index that does not match the stored values */
+    if (_hash_index_mount == mount && !_hash_index_dirty) {
+        char index_path[REGISTRY_MAX_DIR_LEN];
+
+        _hash_index_path(mount, index_path);
+        vfs_unlink(index_path);
+        _hash_index_dirty = true;
+    }
 
     /* create dir path */
     char string_path[REGISTRY_MAX_DIR_LEN];
@@ -377,22 +598,38 @@ static int save(const registry_storage_facility_instance_t *instance, const regi
 
     int fd = vfs_open(string_path, O_CREAT | O_RDWR, 0);
 
-    if (fd <= 0) {
+    if (fd < 0) {
         DEBUG("[registry storage_facility_vfs] save: Can not open file: %d\n", fd);
+        res = fd;
     }
+    else {
+        res = 0;
 
-    if (vfs_write(fd, value.buf, value.buf_len) < 0) {
-        DEBUG("[registry storage_facility_vfs] save: Can not write to file: %d\n", fd);
+        if (vfs_write(fd, value.buf, value.buf_len) < 0) {
+            DEBUG("[registry storage_facility_vfs] save: Can not write to file: %d\n", fd);
+            res = -EIO;
+        }
+
+        if (vfs_close(fd) != 0) {
+            DEBUG("[registry storage_facility_vfs] save: Can not close file: %d\n", fd);
+            res = -EIO;
+        }
     }
 
-    if (vfs_close(fd) != 0) {
-        DEBUG("[registry storage_facility_vfs] save: Can not close file: %d\n", fd);
+    /* only a completely written value may be skipped by the next save */
+    if (_hash_index_mount == mount) {
+        if (res == 0) {
+            _hash_index_update(path, value);
+        }
+        else {
+            _hash_index_remove(path);
+        }
     }
 
     /* umount */
     _umount(mount);
 
-    return 0;
+    return res;
 }
 
 #endif
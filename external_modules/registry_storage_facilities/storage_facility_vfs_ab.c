@@ -0,0 +1,693 @@
+/*
+ * Copyright (C) 2023 HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_registry_cli RIOT Registry Storage Facilities: VFS A/B
+ * @ingroup     sys
+ * @brief       RIOT Registry VFS A/B Storage Facility stores all parameters in one of two slot files, so that saves are atomic.
+ * @{
+ *
+ * @file
+ *
+ * @author      Lasse Rosenow <lasse.rosenow@haw-hamburg.de>
+ */
+
+#include "registry_storage_facilities.h"
+#include "registry_path.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stddef.h>
+#include <kernel_defines.h>
+#include "errno.h"
+#include "vfs.h"
+#include <fcntl.h>
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_VFS_AB) || IS_ACTIVE(DOXYGEN)
+
+#define SLOT_MAGIC 0x52474142 /* "RGAB" */
+#define SLOT_COUNT 2
+#define NO_SLOT -1
+
+/* files inside the mount point that contain the slots. Their names are not valid registry paths,
+   so they do not collide with the VFS storage facility on the same mount point */
+static const char *const _slot_file_names[SLOT_COUNT] = { "/.slot_a", "/.slot_b" };
+
+static int load(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                const load_cb_t cb, const void *cb_arg);
+static int save_start(const registry_storage_facility_instance_t *instance);
+static int save(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                const registry_value_t value);
+static int save_end(const registry_storage_facility_instance_t *instance);
+
+registry_storage_facility_t registry_storage_facility_vfs_ab = {
+    .load = load,
+    .save_start = save_start,
+    .save = save,
+    .save_end = save_end,
+};
+
+typedef struct {
+    uint32_t magic;         /* SLOT_MAGIC */
+    uint32_t seq;           /* sequence number, the valid slot with the highest one is active */
+    uint32_t len;           /* length of the parameters following the header */
+    uint32_t crc;           /* CRC32 of the parameters following the header */
+    uint32_t header_crc;    /* CRC32 of all fields above */
+} _slot_header_t;
+
+typedef struct {
+    uint8_t path_len;       /* amount of ids after namespace_id, schema_id and instance_id */
+    uint8_t type;           /* registry_type_t of the value */
+    uint16_t buf_len;       /* length of the value */
+} _record_header_t;
+
+/* The callback may read the value of the record from fd, it does not have to read all of it */
+typedef int (*_record_cb_t)(const registry_path_t path, const _record_header_t *record,
+                            const int fd, void *arg);
+
+typedef struct {
+    const registry_path_t path;
+    const load_cb_t cb;
+    const void *cb_arg;
+} _load_arg_t;
+
+/* Mounts the mount point, unless it is mounted already.
+   Returns 1 if it has to be unmounted again, 0 if not and negative on failure. */
+static int _mount(vfs_mount_t *mount)
+{
+    int res = vfs_mount(mount);
+
+    if (res == -EBUSY) {
+        return 0;
+    }
+
+    if (res < 0) {
+        DEBUG("[registry storage_facility_vfs_ab] Can not mount %s: %d\n", mount->mount_point, res);
+        return res;
+    }
+
+    return 1;
+}
+
+static int _umount(vfs_mount_t *mount, const bool mounted)
+{
+    if (!mounted) {
+        return 0;
+    }
+
+    int res = vfs_umount(mount);
+
+    if (res < 0) {
+        DEBUG("[registry storage_facility_vfs_ab] Can not unmount %s: %d\n", mount->mount_point,
+              res);
+    }
+
+    return res;
+}
+
+static void _slot_path(const vfs_mount_t *mount, const uint8_t slot, char *string_path)
+{
+    sprintf(string_path, "%s%s", mount->mount_point, _slot_file_names[slot]);
+}
+
+static int _read_header(const vfs_mount_t *mount, const uint8_t slot, _slot_header_t *header)
+{
+    char string_path[REGISTRY_MAX_DIR_LEN];
+
+    _slot_path(mount, slot, string_path);
+
+    int fd = vfs_open(string_path, O_RDONLY, 0);
+
+    if (fd < 0) {
+        return fd;
+    }
+
+    int res = vfs_read(fd, header, sizeof(*header));
+
+    vfs_close(fd);
+
+    if (res != sizeof(*header) || header->magic != SLOT_MAGIC || header->seq == 0 ||
+        header->header_crc != registry_crc32(0, header, offsetof(_slot_header_t, header_crc))) {
+        return -EINVAL;
+    }
+
+    return 0;
+}
+
+static int _verify_slot(const int fd, const _slot_header_t *header)
+{
+    uint8_t buf[32];
+    uint32_t crc = 0;
+    uint32_t remaining = header->len;
+
+    while (remaining > 0) {
+        size_t chunk_len = remaining < sizeof(buf) ? remaining : sizeof(buf);
+        int res = vfs_read(fd, buf, chunk_len);
+
+        if (res <= 0) {
+            return -EIO;
+        }
+
+        crc = registry_crc32(crc, buf, res);
+        remaining -= res;
+    }
+
+    return crc == header->crc ? 0 : -EINVAL;
+}
+
+/* Opens the newest slot whose parameters match its header and moves the file position
+   behind the header. The parameters of a slot are only read to check its CRC, until it
+   was verified once, afterwards only the two headers are read. */
+static int _open_valid_slot(registry_storage_facility_vfs_ab_t *data, _slot_header_t *header,
+                            uint8_t *slot)
+{
+    const vfs_mount_t *mount = data->mount;
+    _slot_header_t headers[SLOT_COUNT];
+    int order[SLOT_COUNT] = { NO_SLOT, NO_SLOT };
+    size_t order_len = 0;
+
+    for (uint8_t i = 0; i < SLOT_COUNT; i++) {
+        if (_read_header(mount, i, &headers[i]) == 0) {
+            order[order_len++] = i;
+        }
+    }
+
+    /* newest slot first, the comparison also works if the sequence number overflowed */
+    if (order_len == SLOT_COUNT && (int32_t)(headers[1].seq - headers[0].seq) > 0) {
+        order[0] = 1;
+        order[1] = 0;
+    }
+
+    for (size_t i = 0; i < order_len; i++) {
+        char string_path[REGISTRY_MAX_DIR_LEN];
+
+        _slot_path(mount, order[i], string_path);
+
+        int fd = vfs_open(string_path, O_RDONLY, 0);
+
+        if (fd < 0) {
+            continue;
+        }
+
+        /* a slot with a valid header can only be broken by the storage itself, so check its CRC */
+        bool verified = headers[order[i]].seq == data->verified_seq;
+
+        if (!verified && vfs_lseek(fd, sizeof(_slot_header_t), SEEK_SET) >= 0 &&
+            _verify_slot(fd, &headers[order[i]]) == 0) {
+            data->verified_seq = headers[order[i]].seq;
+            verified = true;
+        }
+
+        if (verified && vfs_lseek(fd, sizeof(_slot_header_t), SEEK_SET) >= 0) {
+            *header = headers[order[i]];
+            *slot = order[i];
+            return fd;
+        }
+
+        DEBUG("[registry storage_facility_vfs_ab] Slot %d is corrupted\n", order[i]);
+        vfs_close(fd);
+    }
+
+    return -ENOENT;
+}
+
+static int _foreach_record(const int fd, const uint32_t len, const _record_cb_t cb, void *arg)
+{
+    uint32_t pos = 0;
+
+    while (pos < len) {
+        _record_header_t record;
+        registry_id_t ids[REGISTRY_MAX_DIR_DEPTH + 3];
+
+        if (vfs_read(fd, &record, sizeof(record)) != sizeof(record) ||
+            record.path_len > REGISTRY_MAX_DIR_DEPTH) {
+            return -EIO;
+        }
+
+        size_t ids_len = (record.path_len + 3) * sizeof(registry_id_t);
+
+        if (vfs_read(fd, ids, ids_len) != (ssize_t)ids_len) {
+            return -EIO;
+        }
+
+        pos += sizeof(record) + ids_len + record.buf_len;
+
+        if (pos > len) {
+            return -EIO;
+        }
+
+        registry_namespace_id_t namespace_id = ids[0];
+        registry_path_t path = {
+            .namespace_id = &namespace_id,
+            .schema_id = &ids[1],
+            .instance_id = &ids[2],
+            .path = &ids[3],
+            .path_len = record.path_len,
+        };
+
+        int res = cb(path, &record, fd, arg);
+
+        if (res != 0) {
+            return res;
+        }
+
+        /* continue behind the value, no matter how much of it the callback read */
+        if (vfs_lseek(fd, sizeof(_slot_header_t) + pos, SEEK_SET) < 0) {
+            return -EIO;
+        }
+    }
+
+    return 0;
+}
+
+static int _write(registry_storage_facility_vfs_ab_t *data, const void *buf, const size_t len)
+{
+    if (vfs_write(data->fd, buf, len) != (ssize_t)len) {
+        return -EIO;
+    }
+
+    data->crc = registry_crc32(data->crc, buf, len);
+    data->len += len;
+
+    return 0;
+}
+
+static int _write_record_header(registry_storage_facility_vfs_ab_t *data,
+                                const registry_path_t path, const registry_type_t type,
+                                const size_t buf_len)
+{
+    if (path.path_len > REGISTRY_MAX_DIR_DEPTH || buf_len > UINT16_MAX) {
+        return -EINVAL;
+    }
+
+    _record_header_t record = {
+        .path_len = path.path_len,
+        .type = type,
+        .buf_len = buf_len,
+    };
+    registry_id_t ids[REGISTRY_MAX_DIR_DEPTH + 3] = {
+        *path.namespace_id,
+        *path.schema_id,
+        *path.instance_id,
+    };
+
+    if (path.path_len > 0) {
+        memcpy(&ids[3], path.path, path.path_len * sizeof(registry_id_t));
+    }
+
+    int res = _write(data, &record, sizeof(record));
+
+    if (res == 0) {
+        res = _write(data, ids, (path.path_len + 3) * sizeof(registry_id_t));
+    }
+
+    return res;
+}
+
+static int _write_record(registry_storage_facility_vfs_ab_t *data, const registry_path_t path,
+                         const registry_value_t value)
+{
+    int res = _write_record_header(data, path, value.type, value.buf_len);
+
+    if (res == 0) {
+        res = _write(data, value.buf, value.buf_len);
+    }
+
+    return res;
+}
+
+/* Binary search in the sorted saved paths. Returns true if path was found, and sets index to its
+   position or to the position it has to be inserted at */
+static bool _saved_index_find(const registry_storage_facility_vfs_ab_t *data,
+                              const registry_path_t path, size_t *index)
+{
+    size_t low = 0;
+    size_t high = data->saved_len;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        registry_id_t ids[REGISTRY_MAX_DIR_DEPTH + 3];
+        registry_path_t mid_path;
+
+        registry_path_unpack(&data->saved[mid], ids, &mid_path);
+
+        int cmp = registry_path_cmp(path, mid_path);
+
+        if (cmp == 0) {
+            *index = mid;
+            return true;
+        }
+
+        if (cmp < 0) {
+            high = mid;
+        }
+        else {
+            low = mid + 1;
+        }
+    }
+
+    *index = low;
+    return false;
+}
+
+static void _saved_index_add(registry_storage_facility_vfs_ab_t *data, const registry_path_t path)
+{
+    size_t index;
+    registry_path_packed_t packed;
+
+    if (_saved_index_find(data, path, &index)) {
+        return;
+    }
+
+    if (data->saved_len >= ARRAY_SIZE(data->saved) || registry_path_pack(path, &packed) != 0) {
+        /* the path can still be found in the written slot */
+        data->saved_overflow = true;
+        return;
+    }
+
+    memmove(&data->saved[index + 1], &data->saved[index],
+            (data->saved_len - index) * sizeof(data->saved[0]));
+    data->saved[index] = packed;
+    data->saved_len++;
+}
+
+static int _match_record_cb(const registry_path_t path, const _record_header_t *record,
+                            const int fd, void *arg)
+{
+    (void)record;
+    (void)fd;
+
+    const registry_path_t *search_path = arg;
+
+    return registry_path_equal(path, *search_path) ? 1 : 0;
+}
+
+/* Returns 1 if the parameter was written during the current save, 0 if not and negative on
+   failure */
+static int _is_saved(registry_storage_facility_vfs_ab_t *data, const registry_path_t path)
+{
+    size_t index;
+
+    if (_saved_index_find(data, path, &index)) {
+        return 1;
+    }
+
+    if (!data->saved_overflow) {
+        return 0;
+    }
+
+    /* search the parameters that were written by save, then continue writing at the end */
+    registry_path_t search_path = path;
+    int res = -EIO;
+
+    if (vfs_lseek(data->fd, sizeof(_slot_header_t), SEEK_SET) >= 0) {
+        res = _foreach_record(data->fd, data->saved_records_len, _match_record_cb, &search_path);
+    }
+
+    if (vfs_lseek(data->fd, sizeof(_slot_header_t) + data->len, SEEK_SET) < 0) {
+        return -EIO;
+    }
+
+    return res;
+}
+
+static int _load_record_cb(const registry_path_t path, const _record_header_t *record,
+                           const int fd, void *arg)
+{
+    _load_arg_t *load_arg = arg;
+
+    if (!registry_path_is_prefix(load_arg->path, path)) {
+        return 0;
+    }
+
+    /* the registry copies the whole parameter from the loaded value, so a value that was stored
+       with another type or length (e.g. before a schema change) is skipped */
+    registry_value_t expected;
+
+    if (registry_load_expected_value(path, &expected) != 0 || record->type != expected.type ||
+        record->buf_len != expected.buf_len) {
+        DEBUG("[registry storage_facility_vfs_ab] load: Skipping unknown parameter\n");
+        return 0;
+    }
+
+    /* uint64_t to keep the value aligned */
+    uint64_t buf[record->buf_len / sizeof(uint64_t) + 1];
+
+    if (vfs_read(fd, buf, record->buf_len) != record->buf_len) {
+        return -EIO;
+    }
+
+    registry_value_t value = {
+        .type = record->type,
+        .buf = buf,
+        .buf_len = record->buf_len,
+    };
+
+    load_arg->cb(path, value, load_arg->cb_arg);
+
+    return 0;
+}
+
+static int _copy_record_cb(const registry_path_t path, const _record_header_t *record,
+                           const int fd, void *arg)
+{
+    registry_storage_facility_vfs_ab_t *data = arg;
+
+    /* parameters that were saved in this session already have their new value in the slot */
+    int res = _is_saved(data, path);
+
+    if (res != 0) {
+        return res < 0 ? res : 0;
+    }
+
+    res = _write_record_header(data, path, record->type, record->buf_len);
+
+    /* copy the value in chunks, so that no buffer of its size is needed */
+    uint8_t buf[32];
+    size_t remaining = record->buf_len;
+
+    while (res == 0 && remaining > 0) {
+        size_t chunk_len = remaining < sizeof(buf) ? remaining : sizeof(buf);
+
+        if (vfs_read(fd, buf, chunk_len) != (ssize_t)chunk_len) {
+            return -EIO;
+        }
+
+        res = _write(data, buf, chunk_len);
+        remaining -= chunk_len;
+    }
+
+    return res;
+}
+
+static int load(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                const load_cb_t cb, const void *cb_arg)
+{
+    registry_storage_facility_vfs_ab_t *data = instance->data;
+    _slot_header_t header;
+    uint8_t slot;
+    int res = 0;
+    int mounted = _mount(data->mount);
+
+    if (mounted < 0) {
+        return mounted;
+    }
+
+    int fd = _open_valid_slot(data, &header, &slot);
+
+    if (fd >= 0) {
+        _load_arg_t load_arg = {
+            .path = path,
+            .cb = cb,
+            .cb_arg = cb_arg,
+        };
+
+        res = _foreach_record(fd, header.len, _load_record_cb, &load_arg);
+        vfs_close(fd);
+    }
+
+    if (_umount(data->mount, mounted) < 0 && res == 0) {
+        res = -EIO;
+    }
+
+    return res;
+}
+
+static int save_start(const registry_storage_facility_instance_t *instance)
+{
+    registry_storage_facility_vfs_ab_t *data = instance->data;
+    _slot_header_t header;
+    uint8_t slot;
+
+    data->len = 0;
+    data->crc = 0;
+    data->res = 0;
+    data->saved_len = 0;
+    data->saved_overflow = false;
+    data->fd = -1;
+
+    int mounted = _mount(data->mount);
+
+    if (mounted < 0) {
+        data->res = mounted;
+        return data->res;
+    }
+
+    data->mounted = mounted;
+
+    /* the newest valid slot stays untouched until the other slot is complete */
+    int fd = _open_valid_slot(data, &header, &slot);
+
+    if (fd >= 0) {
+        vfs_close(fd);
+        data->seq = header.seq;
+        data->active = slot;
+    }
+    else {
+        data->seq = 0;
+        data->active = SLOT_COUNT - 1;
+    }
+
+    char string_path[REGISTRY_MAX_DIR_LEN];
+
+    _slot_path(data->mount, (data->active + 1) % SLOT_COUNT, string_path);
+
+    /* the slot is also read, if not all saved paths fit into the saved index */
+    data->fd = vfs_open(string_path, O_CREAT | O_RDWR | O_TRUNC, 0);
+
+    if (data->fd < 0) {
+        DEBUG("[registry storage_facility_vfs_ab] save_start: Can not open file: %d\n", data->fd);
+        data->res = data->fd;
+        _umount(data->mount, data->mounted);
+        return data->res;
+    }
+
+    /* reserve space for the header, which is only written once the slot is complete */
+    _slot_header_t empty_header = { 0 };
+
+    if (vfs_write(data->fd, &empty_header, sizeof(empty_header)) != sizeof(empty_header)) {
+        /* registry_save does not call save_end after a failed save_start */
+        data->res = -EIO;
+        vfs_close(data->fd);
+        data->fd = -1;
+        _umount(data->mount, data->mounted);
+    }
+
+    return data->res;
+}
+
+static int save(const registry_storage_facility_instance_t *instance, const registry_path_t path,
+                const registry_value_t value)
+{
+    registry_storage_facility_vfs_ab_t *data = instance->data;
+
+    if (data->res != 0) {
+        return data->res;
+    }
+
+    data->res = _write_record(data, path, value);
+
+    if (data->res == 0) {
+        _saved_index_add(data, path);
+    }
+
+    return data->res;
+}
+
+static int save_end(const registry_storage_facility_instance_t *instance)
+{
+    registry_storage_facility_vfs_ab_t *data = instance->data;
+
+    if (data->fd < 0) {
+        return data->res;
+    }
+
+    data->saved_records_len = data->len;
+
+    /* copy the parameters of the active slot that were not saved in this session */
+    if (data->res == 0 && data->seq != 0) {
+        char string_path[REGISTRY_MAX_DIR_LEN];
+        _slot_header_t header;
+
+        if (_read_header(data->mount, data->active, &header) == 0) {
+            _slot_path(data->mount, data->active, string_path);
+
+            int fd = vfs_open(string_path, O_RDONLY, 0);
+
+            if (fd < 0 || vfs_lseek(fd, sizeof(_slot_header_t), SEEK_SET) < 0) {
+                data->res = -EIO;
+            }
+            else {
+                data->res = _foreach_record(fd, header.len, _copy_record_cb, data);
+            }
+
+            if (fd >= 0) {
+                vfs_close(fd);
+            }
+        }
+    }
+
+    /* make sure all parameters are stored, before the header marks the slot as valid */
+    if (data->res == 0 && vfs_fsync(data->fd) < 0) {
+        data->res = -EIO;
+    }
+
+    uint32_t seq = data->seq + 1;
+
+    if (seq == 0) {
+        seq = 1;
+    }
+
+    if (data->res == 0) {
+        _slot_header_t header = {
+            .magic = SLOT_MAGIC,
+            .seq = seq,
+            .len = data->len,
+            .crc = data->crc,
+        };
+
+        header.header_crc = registry_crc32(0, &header, offsetof(_slot_header_t, header_crc));
+
+        if (vfs_lseek(data->fd, 0, SEEK_SET) < 0 ||
+            vfs_write(data->fd, &header, sizeof(header)) != sizeof(header) ||
+            vfs_fsync(data->fd) < 0) {
+            data->res = -EIO;
+        }
+    }
+
+    vfs_close(data->fd);
+    data->fd = -1;
+
+    /* the header is already synced, so the written slot is valid even if this fails */
+    int umount_res = _umount(data->mount, data->mounted);
+
+    /* the written slot is the active one now */
+    if (data->res == 0) {
+        data->seq = seq;
+        data->active = (data->active + 1) % SLOT_COUNT;
+        /* the CRC was calculated from the written parameters, so the slot does not have to be
+           read again to verify it */
+        data->verified_seq = seq;
+    }
+    else {
+        DEBUG("[registry storage_facility_vfs_ab] save_end: Save failed, slot %d stays active: %d\n",
+              data->active, data->res);
+    }
+
+    if (data->res == 0 && umount_res < 0) {
+        data->res = -EIO;
+    }
+
+    return data->res;
+}
+
+#endif
+
+/** @} */
@@ -25,8 +25,32 @@ extern "C" {
 #endif
 
 #include "registry.h"
+#include "thread.h"
+
+/**
+ * @brief Maximum amount of stack in bytes that a single registry function may use
+ * in @ref registry_tests_stack_run(), not counting the stack of the thread itself.
+ */
+#ifndef CONFIG_REGISTRY_TESTS_STACK_BUDGET
+#define CONFIG_REGISTRY_TESTS_STACK_BUDGET (THREAD_STACKSIZE_DEFAULT / 2)
+#endif
 
 int registry_tests_api_run(void);
+
+/**
+ * @brief Runs the unit tests of the path utilities, see registry_path.h.
+ *
+ * @return 0
+ */
+int registry_tests_path_run(void);
+
+/**
+ * @brief Runs every public registry function in a fresh thread with a painted stack and reports
+ * the high-water mark of its stack usage. The test fails if a function exceeds
+ * @ref CONFIG_REGISTRY_TESTS_STACK_BUDGET.
+ *
+ * @return Amount of functions that exceeded @ref CONFIG_REGISTRY_TESTS_STACK_BUDGET
+ */
 int registry_tests_stack_run(void);
 
 /** @} */
@@ -22,10 +22,12 @@
 #include <stdint.h>
 #include <float.h>
 #include <inttypes.h>
+#include <errno.h>
 #include "embUnit.h"
 #include "fmt.h"
 #include "assert.h"
 #include "registry.h"
+#include "registry_conversion.h"
 #include "registry_schemas.h"
 #include "registry_storage_facilities.h"
 #include "vfs.h"
@@ -34,6 +36,10 @@
 
 #include "registry_tests.h"
 
+#if IS_USED(MODULE_REGISTRY_SNAPSHOT)
+#include "registry_snapshot.h"
+#endif /* MODULE_REGISTRY_SNAPSHOT */
+
 #define FLOAT_MAX_CHAR_COUNT ((FLT_MAX_10_EXP + 1) + 1 + 1 + 6)     // (FLT_MAX_10_EXP + 1) + sign + dot + 6 decimal places
 #define DOUBLE_MAX_CHAR_COUNT ((DBL_MAX_10_EXP + 1) + 1 + 1 + 6)    // (DBL_MAX_10_EXP + 1) + sign + dot + 6 decimal places
 
@@ -68,6 +74,34 @@ static registry_storage_facility_instance_t vfs_instance_2 = {
     .data = &_vfs_mount,
 };
 
+#if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP)
+static registry_storage_facility_heap_t heap_high_data;
+static registry_storage_facility_heap_t heap_low_data;
+
+static registry_storage_facility_instance_t heap_high_instance = {
+    .itf = &registry_storage_facility_heap,
+    .data = &heap_high_data,
+    .priority = 1,
+};
+
+static registry_storage_facility_instance_t heap_low_instance = {
+    .itf = &registry_storage_facility_heap,
+    .data = &heap_low_data,
+    .priority = 0,
+};
+#endif /* CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_VFS_AB)
+static registry_storage_facility_vfs_ab_t vfs_ab_data = {
+    .mount = &_vfs_mount,
+};
+
+static registry_storage_facility_instance_t vfs_ab_instance = {
+    .itf = &registry_storage_facility_vfs_ab,
+    .data = &vfs_ab_data,
+};
+#endif /* CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_VFS_AB */
+
 static bool commit_success = false;
 
 static int test_instance_0_commit_cb(const registry_path_t path, const void *context)
@@ -467,6 +501,102 @@ static void tests_registry_export(void)
     TEST_ASSERT_EQUAL_INT(true, export_success);
 }
 
+static void tests_registry_iter(void)
+{
+    registry_iter_t iter;
+    registry_iter_entry_t entry;
+    size_t parameters = 0;
+
+    /* the namespace, schema and instance come first, followed by all parameters */
+    registry_iter_init(&iter, REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0), 0);
+
+    TEST_ASSERT_EQUAL_INT(0, registry_iter_next(&iter, &entry));
+    TEST_ASSERT(entry.schema == NULL);
+    TEST_ASSERT_EQUAL_INT(0, registry_iter_next(&iter, &entry));
+    TEST_ASSERT(entry.schema == &registry_schema_full_example);
+    TEST_ASSERT(entry.instance == NULL);
+    TEST_ASSERT_EQUAL_INT(0, registry_iter_next(&iter, &entry));
+    TEST_ASSERT(entry.instance == &test_instance_1);
+    TEST_ASSERT(entry.meta == NULL);
+
+    while (registry_iter_next(&iter, &entry) == 0) {
+        TEST_ASSERT(entry.value != NULL);
+        TEST_ASSERT_EQUAL_INT(entry.meta->id, entry.path.path[entry.path.path_len - 1]);
+        parameters++;
+    }
+
+    TEST_ASSERT_EQUAL_INT(registry_schema_full_example.items_len, parameters);
+    TEST_ASSERT_EQUAL_INT(-ENOENT, registry_iter_next(&iter, &entry));
+
+    /* the namespace and schema of the path are returned before the unknown instance */
+    registry_iter_init(&iter, REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 100), 0);
+
+    TEST_ASSERT_EQUAL_INT(0, registry_iter_next(&iter, &entry));
+    TEST_ASSERT_EQUAL_INT(0, registry_iter_next(&iter, &entry));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, registry_iter_next(&iter, &entry));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, registry_iter_next(&iter, &entry));
+}
+
+static size_t export_page_count;
+
+static int _export_page_func(const registry_path_t path, const registry_schema_t *schema,
+                             const registry_instance_t *instance,
+                             const registry_schema_item_t *meta,
+                             const registry_value_t *value, const void *context)
+{
+    (void)path;
+    (void)schema;
+    (void)instance;
+    (void)meta;
+    (void)value;
+    (void)context;
+
+    export_page_count++;
+
+    return 0;
+}
+
+static void tests_registry_export_page(void)
+{
+    registry_path_t path = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0);
+    registry_export_token_t token = { 0 };
+    size_t pages = 0;
+
+    /* namespace, schema and instance followed by all parameters */
+    const size_t entries = 3 + registry_schema_full_example.items_len;
+
+    export_page_count = 0;
+    while (registry_export_page(_export_page_func, path, 0, &token, 2, NULL) == 1) {
+        pages++;
+        TEST_ASSERT_EQUAL_INT(pages * 2, export_page_count);
+    }
+
+    TEST_ASSERT_EQUAL_INT(entries, export_page_count);
+    TEST_ASSERT_EQUAL_INT((entries + 1) / 2, pages + 1);
+
+    /* a page that ends with the last node completes the export */
+    memset(&token, 0, sizeof(token));
+    TEST_ASSERT_EQUAL_INT(0, registry_export_page(_export_page_func, path, 0, &token, entries,
+                                                  NULL));
+
+    /* empty pages would never make progress */
+    memset(&token, 0, sizeof(token));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, registry_export_page(_export_page_func, path, 0, &token, 0,
+                                                        NULL));
+}
+
+static void tests_registry_export_missing(void)
+{
+    registry_path_t schema_path = REGISTRY_PATH_SYS(UINT32_MAX);
+    registry_path_t instance_path = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 9);
+    registry_path_t item_path = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0, UINT32_MAX);
+
+    /* nodes of the path that do not exist are reported instead of exporting nothing */
+    TEST_ASSERT_EQUAL_INT(-EINVAL, registry_export(_export_page_func, schema_path, 0, NULL));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, registry_export(_export_page_func, instance_path, 0, NULL));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, registry_export(_export_page_func, item_path, 0, NULL));
+}
+
 static void tests_registry_save_load(void)
 {
     registry_path_t path = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
@@ -488,6 +618,471 @@ static void tests_registry_save_load(void)
     TEST_ASSERT_EQUAL_INT(old_value, *new_value);
 }
 
+static void tests_registry_set_from_str(void)
+{
+    registry_path_t u8_path = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                                REGISTRY_SCHEMA_FULL_EXAMPLE_U8);
+    registry_path_t i16_path = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                                 REGISTRY_SCHEMA_FULL_EXAMPLE_I16);
+    registry_path_t string_path = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                                    REGISTRY_SCHEMA_FULL_EXAMPLE_STRING);
+    const uint8_t *u8;
+    const int16_t *i16;
+    const char *string;
+    size_t string_len;
+
+    TEST_ASSERT_EQUAL_INT(0, registry_set_from_str(u8_path, "42"));
+    registry_get_uint8(u8_path, &u8);
+    TEST_ASSERT_EQUAL_INT(42, *u8);
+
+    /* values that do not fit or cannot be parsed keep the old value */
+    TEST_ASSERT_EQUAL_INT(-EINVAL, registry_set_from_str(u8_path, "256"));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, registry_set_from_str(u8_path, "4x"));
+    registry_get_uint8(u8_path, &u8);
+    TEST_ASSERT_EQUAL_INT(42, *u8);
+
+    TEST_ASSERT_EQUAL_INT(0, registry_set_from_str(i16_path, "-1234"));
+    registry_get_int16(i16_path, &i16);
+    TEST_ASSERT_EQUAL_INT(-1234, *i16);
+
+    TEST_ASSERT_EQUAL_INT(0, registry_set_from_str(string_path, "hello"));
+    registry_get_string(string_path, &string, &string_len);
+    TEST_ASSERT_EQUAL_STRING("hello", string);
+}
+
+static void tests_registry_convert(void)
+{
+    registry_path_t u8_path = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                                REGISTRY_SCHEMA_FULL_EXAMPLE_U8);
+    registry_path_t i16_path = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                                 REGISTRY_SCHEMA_FULL_EXAMPLE_I16);
+    const uint8_t *u8;
+    const int16_t *i16;
+    uint32_t u32 = UINT32_MAX;
+    int32_t i32 = -1234;
+    registry_value_t value = { .type = REGISTRY_TYPE_UINT32, .buf = &u32,
+                               .buf_len = sizeof(u32) };
+    char string[11];
+
+    /* the whole value and its null terminator fit, without leading whitespace */
+    TEST_ASSERT_NOT_NULL(registry_convert_value_to_str(&value, string, sizeof(string)));
+    TEST_ASSERT_EQUAL_STRING("4294967295", string);
+    TEST_ASSERT_NULL(registry_convert_value_to_str(&value, string, sizeof(string) - 1));
+
+    value = (registry_value_t){ .type = REGISTRY_TYPE_INT32, .buf = &i32, .buf_len = sizeof(i32) };
+    TEST_ASSERT_NOT_NULL(registry_convert_value_to_str(&value, string, sizeof(string)));
+    TEST_ASSERT_EQUAL_STRING("-1234", string);
+
+    /* setting a value of another type converts it */
+    TEST_ASSERT_EQUAL_INT(0, registry_set_uint32(u8_path, 200));
+    registry_get_uint8(u8_path, &u8);
+    TEST_ASSERT_EQUAL_INT(200, *u8);
+
+    TEST_ASSERT_EQUAL_INT(0, registry_set_int32(i16_path, -300));
+    registry_get_int16(i16_path, &i16);
+    TEST_ASSERT_EQUAL_INT(-300, *i16);
+
+    /* values that do not fit into the parameter are not truncated */
+    TEST_ASSERT_EQUAL_INT(-EINVAL, registry_set_uint32(u8_path, UINT32_MAX));
+    registry_get_uint8(u8_path, &u8);
+    TEST_ASSERT_EQUAL_INT(200, *u8);
+}
+
+#if !IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD)
+static void tests_registry_path_from_names(void)
+{
+    registry_id_t ids[REGISTRY_MAX_DIR_DEPTH + 3];
+    registry_path_t path;
+
+    TEST_ASSERT_EQUAL_INT(0, registry_path_from_names("sys/test/test-1/u8", ids, &path));
+    TEST_ASSERT_EQUAL_INT(REGISTRY_ROOT_GROUP_SYS, *path.namespace_id);
+    TEST_ASSERT_EQUAL_INT(REGISTRY_SCHEMA_FULL_EXAMPLE, *path.schema_id);
+    TEST_ASSERT_EQUAL_INT(0, *path.instance_id);
+    TEST_ASSERT_EQUAL_INT(1, path.path_len);
+    TEST_ASSERT_EQUAL_INT(REGISTRY_SCHEMA_FULL_EXAMPLE_U8, path.path[0]);
+
+    /* names and ids can be mixed */
+    TEST_ASSERT_EQUAL_INT(0, registry_path_from_names("0/test/0", ids, &path));
+    TEST_ASSERT_EQUAL_INT(REGISTRY_SCHEMA_FULL_EXAMPLE, *path.schema_id);
+    TEST_ASSERT_EQUAL_INT(0, path.path_len);
+
+    TEST_ASSERT_EQUAL_INT(-ENOENT, registry_path_from_names("sys/test/test-1/u9", ids, &path));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, registry_path_from_names("sys/test/test-1/u8/u8", ids, &path));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, registry_path_from_names("sys//test", ids, &path));
+}
+#endif /* !CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD */
+
+static void tests_registry_path_pack(void)
+{
+    registry_path_t path = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                             REGISTRY_SCHEMA_FULL_EXAMPLE_U8);
+    registry_path_packed_t packed;
+    registry_path_packed_t packed_again;
+    registry_id_t ids[REGISTRY_MAX_DIR_DEPTH + 3];
+    registry_path_t unpacked;
+
+    TEST_ASSERT_EQUAL_INT(0, registry_path_pack(path, &packed));
+    TEST_ASSERT_EQUAL_INT(4, packed.ids_len);
+
+    registry_path_unpack(&packed, ids, &unpacked);
+    TEST_ASSERT_EQUAL_INT(REGISTRY_ROOT_GROUP_SYS, *unpacked.namespace_id);
+    TEST_ASSERT_EQUAL_INT(REGISTRY_SCHEMA_FULL_EXAMPLE, *unpacked.schema_id);
+    TEST_ASSERT_EQUAL_INT(0, *unpacked.instance_id);
+    TEST_ASSERT_EQUAL_INT(1, unpacked.path_len);
+    TEST_ASSERT_EQUAL_INT(REGISTRY_SCHEMA_FULL_EXAMPLE_U8, unpacked.path[0]);
+
+    /* unused ids are 0, so packing the same path again results in the same bytes */
+    TEST_ASSERT_EQUAL_INT(0, registry_path_pack(unpacked, &packed_again));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&packed, &packed_again, sizeof(packed)));
+
+    /* the root of the registry has no ids */
+    TEST_ASSERT_EQUAL_INT(0, registry_path_pack(_REGISTRY_PATH_0(), &packed));
+    TEST_ASSERT_EQUAL_INT(0, packed.ids_len);
+    registry_path_unpack(&packed, ids, &unpacked);
+    TEST_ASSERT(unpacked.namespace_id == NULL);
+
+    path = REGISTRY_PATH_APP(REGISTRY_PATH_PACKED_ID_MAX + 1);
+    TEST_ASSERT_EQUAL_INT(-EINVAL, registry_path_pack(path, &packed));
+}
+
+static void tests_registry_schema_item(void)
+{
+    const registry_schema_item_t *item = NULL;
+
+    for (size_t i = 0; i < registry_schema_full_example.items_len; i++) {
+        if (registry_schema_full_example.items[i].id == REGISTRY_SCHEMA_FULL_EXAMPLE_U8) {
+            item = &registry_schema_full_example.items[i];
+        }
+    }
+
+    TEST_ASSERT(item != NULL);
+    TEST_ASSERT_EQUAL_INT(REGISTRY_SCHEMA_TYPE_PARAMETER, item->kind);
+    TEST_ASSERT_EQUAL_INT(REGISTRY_TYPE_UINT8, item->value_type);
+
+    /* name and description share one string, but are returned separately */
+#if IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD)
+    TEST_ASSERT_EQUAL_STRING("", registry_schema_item_name(item));
+#else
+    TEST_ASSERT_EQUAL_STRING("u8", registry_schema_item_name(item));
+#endif
+#if IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_DESCRIPTION_FIELD)
+    TEST_ASSERT_EQUAL_STRING("", registry_schema_item_description(item));
+#else
+    TEST_ASSERT_EQUAL_STRING("Example u8 description.", registry_schema_item_description(item));
+#endif
+}
+
+static void tests_registry_load_expected_value(void)
+{
+    registry_value_t value;
+
+    TEST_ASSERT_EQUAL_INT(0, registry_load_expected_value(
+                              REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                                REGISTRY_SCHEMA_FULL_EXAMPLE_U8), &value));
+    TEST_ASSERT_EQUAL_INT(REGISTRY_TYPE_UINT8, value.type);
+    TEST_ASSERT_EQUAL_INT(sizeof(uint8_t), value.buf_len);
+
+    /* consecutive parameters of the same instance reuse the lookup */
+    TEST_ASSERT_EQUAL_INT(0, registry_load_expected_value(
+                              REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                                REGISTRY_SCHEMA_FULL_EXAMPLE_STRING), &value));
+    TEST_ASSERT_EQUAL_INT(REGISTRY_TYPE_STRING, value.type);
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, registry_load_expected_value(
+                              REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 1,
+                                                REGISTRY_SCHEMA_FULL_EXAMPLE_U8), &value));
+}
+
+#if IS_ACTIVE(CONFIG_REGISTRY_STATS)
+static void tests_registry_stats(void)
+{
+    registry_path_t path = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                             REGISTRY_SCHEMA_FULL_EXAMPLE_U8);
+    registry_stats_t stats;
+    const uint8_t *value;
+
+    registry_stats_reset();
+
+    registry_set_uint8(path, 1);
+    registry_set_uint32(path, 2);
+    registry_get_uint8(path, &value);
+    registry_get_uint8(REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 1,
+                                         REGISTRY_SCHEMA_FULL_EXAMPLE_U8), &value);
+
+    registry_stats_get(&stats);
+
+    TEST_ASSERT_EQUAL_INT(2, stats.ops[REGISTRY_STATS_OP_SET].calls);
+    TEST_ASSERT_EQUAL_INT(0, stats.ops[REGISTRY_STATS_OP_SET].errors);
+    TEST_ASSERT_EQUAL_INT(1, stats.conversions);
+    TEST_ASSERT_EQUAL_INT(2, stats.ops[REGISTRY_STATS_OP_GET].calls);
+    TEST_ASSERT_EQUAL_INT(1, stats.ops[REGISTRY_STATS_OP_GET].errors);
+    TEST_ASSERT_EQUAL_INT(0, stats.ops[REGISTRY_STATS_OP_SAVE].calls);
+
+    /* every call is counted in exactly one bucket of the histogram */
+    uint32_t histogram_calls = 0;
+    for (size_t i = 0; i < CONFIG_REGISTRY_STATS_HISTOGRAM_BUCKETS; i++) {
+        histogram_calls += stats.ops[REGISTRY_STATS_OP_GET].histogram[i];
+    }
+    TEST_ASSERT_EQUAL_INT(2, histogram_calls);
+}
+#endif /* CONFIG_REGISTRY_STATS */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_TRACE)
+static void _trace_cb(const registry_trace_event_t *event, void *context)
+{
+    registry_trace_event_t *events = context;
+
+    /* keep the last event of every operation */
+    events[event->op] = *event;
+}
+
+static void tests_registry_trace(void)
+{
+    /* zeroed, so that an event that was not recorded fails the asserts below */
+    registry_trace_event_t events[REGISTRY_TRACE_OP_SAVE + 1] = { 0 };
+
+    /* drop all previous events */
+    registry_trace_drain(_trace_cb, events);
+    memset(events, 0, sizeof(events));
+
+    registry_set_uint8(REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                         REGISTRY_SCHEMA_FULL_EXAMPLE_U8), 7);
+    registry_commit(REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE));
+
+    TEST_ASSERT_EQUAL_INT(0, registry_trace_drain(_trace_cb, events));
+
+    const registry_trace_event_t *set = &events[REGISTRY_TRACE_OP_SET];
+    const registry_trace_event_t *commit = &events[REGISTRY_TRACE_OP_COMMIT];
+
+    TEST_ASSERT_EQUAL_INT(REGISTRY_TRACE_OP_SET, set->op);
+    TEST_ASSERT_EQUAL_INT(0, set->res);
+    TEST_ASSERT_EQUAL_INT(4, set->path_len);
+    TEST_ASSERT_EQUAL_INT(REGISTRY_ROOT_GROUP_SYS, set->namespace_id);
+    TEST_ASSERT_EQUAL_INT(REGISTRY_SCHEMA_FULL_EXAMPLE, set->ids[0]);
+    TEST_ASSERT_EQUAL_INT(0, set->ids[1]);
+    TEST_ASSERT_EQUAL_INT(REGISTRY_SCHEMA_FULL_EXAMPLE_U8, set->ids[2]);
+
+    TEST_ASSERT_EQUAL_INT(REGISTRY_TRACE_OP_COMMIT, commit->op);
+    TEST_ASSERT_EQUAL_INT(2, commit->path_len);
+    TEST_ASSERT_EQUAL_INT(set->seq + 1, commit->seq);
+}
+#endif /* CONFIG_REGISTRY_TRACE */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP)
+static void tests_registry_load_priority(void)
+{
+    registry_path_t path_u8 = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                                REGISTRY_SCHEMA_FULL_EXAMPLE_U8);
+    registry_path_t path_u16 = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                                 REGISTRY_SCHEMA_FULL_EXAMPLE_U16);
+
+    /* only use the two heap storage facilities as sources, the low priority one is registered first */
+    registry_init();
+    registry_register_storage_facility_src(&heap_low_instance);
+    registry_register_storage_facility_src(&heap_high_instance);
+
+    /* the low priority source contains all parameters, the high priority source only u8 */
+    registry_set_uint8(path_u8, 1);
+    registry_set_uint16(path_u16, 1);
+    registry_register_storage_facility_dst(&heap_low_instance);
+    registry_save(REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0));
+
+    const uint8_t high_u8 = 2;
+    registry_value_t high_value = {
+        .type = REGISTRY_TYPE_UINT8,
+        .buf = &high_u8,
+        .buf_len = sizeof(high_u8),
+    };
+    heap_high_instance.itf->save(&heap_high_instance, path_u8, high_value);
+
+    registry_set_uint8(path_u8, 3);
+    registry_set_uint16(path_u16, 3);
+
+    TEST_ASSERT_EQUAL_INT(0, registry_load(_REGISTRY_PATH_0()));
+
+    const uint8_t *output_u8;
+    const uint16_t *output_u16;
+
+    registry_get_uint8(path_u8, &output_u8);
+    registry_get_uint16(path_u16, &output_u16);
+
+    TEST_ASSERT_EQUAL_INT(2, *output_u8);
+    TEST_ASSERT_EQUAL_INT(1, *output_u16);
+}
+#endif /* CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_LAZY_LOAD) && IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP)
+static void tests_registry_lazy_load(void)
+{
+    registry_path_t path_u8 = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                                REGISTRY_SCHEMA_FULL_EXAMPLE_U8);
+    uint8_t stored_u8 = 7;
+    registry_value_t stored_value = {
+        .type = REGISTRY_TYPE_UINT8,
+        .buf = &stored_u8,
+        .buf_len = sizeof(stored_u8),
+    };
+
+    registry_init();
+    registry_register_storage_facility_src(&heap_low_instance);
+    heap_low_instance.itf->save(&heap_low_instance, path_u8, stored_value);
+
+    /* the first access of the instance loads it */
+    test_instance_1.loaded = false;
+    test_instance_1_data.u8 = 0;
+
+    const uint8_t *output_u8;
+
+    registry_get_uint8(path_u8, &output_u8);
+    TEST_ASSERT_EQUAL_INT(7, *output_u8);
+
+    /* later accesses do not load it again */
+    stored_u8 = 8;
+    heap_low_instance.itf->save(&heap_low_instance, path_u8, stored_value);
+
+    registry_get_uint8(path_u8, &output_u8);
+    TEST_ASSERT_EQUAL_INT(7, *output_u8);
+}
+
+static void tests_registry_lazy_load_expected_value(void)
+{
+    registry_path_t path_u8 = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                                REGISTRY_SCHEMA_FULL_EXAMPLE_U8);
+    uint8_t stored_u8 = 7;
+    registry_value_t stored_value = {
+        .type = REGISTRY_TYPE_UINT8,
+        .buf = &stored_u8,
+        .buf_len = sizeof(stored_u8),
+    };
+    registry_value_t value;
+
+    registry_init();
+    registry_register_storage_facility_src(&heap_low_instance);
+    heap_low_instance.itf->save(&heap_low_instance, path_u8, stored_value);
+
+    test_instance_1.loaded = false;
+    test_instance_1_data.u8 = 0;
+
+    /* storage facilities call it while they load, so it must not load the instance itself */
+    TEST_ASSERT_EQUAL_INT(0, registry_load_expected_value(path_u8, &value));
+    TEST_ASSERT_EQUAL_INT(REGISTRY_TYPE_UINT8, value.type);
+    TEST_ASSERT_EQUAL_INT(0, *(const uint8_t *)value.buf);
+    TEST_ASSERT_EQUAL_INT(false, test_instance_1.loaded);
+}
+#endif /* CONFIG_REGISTRY_LAZY_LOAD && CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP */
+
+#if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_VFS_AB)
+static void tests_registry_vfs_ab(void)
+{
+    registry_path_t path_u8 = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                                REGISTRY_SCHEMA_FULL_EXAMPLE_U8);
+    registry_path_t path_u16 = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                                 REGISTRY_SCHEMA_FULL_EXAMPLE_U16);
+
+    registry_init();
+    registry_register_storage_facility_src(&vfs_ab_instance);
+    registry_register_storage_facility_dst(&vfs_ab_instance);
+
+    /* the first save writes all parameters into one slot */
+    registry_set_uint8(path_u8, 1);
+    registry_set_uint16(path_u16, 1);
+    TEST_ASSERT_EQUAL_INT(0, registry_save(REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0)));
+
+    /* saving a single parameter writes the other slot, which still contains all other parameters */
+    const uint8_t new_u8 = 2;
+    registry_value_t new_value = {
+        .type = REGISTRY_TYPE_UINT8,
+        .buf = &new_u8,
+        .buf_len = sizeof(new_u8),
+    };
+    uint8_t active = vfs_ab_data.active;
+
+    vfs_ab_instance.itf->save_start(&vfs_ab_instance);
+    vfs_ab_instance.itf->save(&vfs_ab_instance, path_u8, new_value);
+    TEST_ASSERT_EQUAL_INT(0, vfs_ab_instance.itf->save_end(&vfs_ab_instance));
+    TEST_ASSERT(active != vfs_ab_data.active);
+
+    registry_set_uint8(path_u8, 3);
+    registry_set_uint16(path_u16, 3);
+
+    TEST_ASSERT_EQUAL_INT(0, registry_load(_REGISTRY_PATH_0()));
+
+    const uint8_t *output_u8;
+    const uint16_t *output_u16;
+
+    registry_get_uint8(path_u8, &output_u8);
+    registry_get_uint16(path_u16, &output_u16);
+
+    TEST_ASSERT_EQUAL_INT(2, *output_u8);
+    TEST_ASSERT_EQUAL_INT(1, *output_u16);
+}
+#endif /* CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_VFS_AB */
+
+#if IS_USED(MODULE_REGISTRY_SNAPSHOT)
+static uint8_t snapshot[256];
+static size_t snapshot_len;
+static size_t snapshot_pos;
+
+static int snapshot_write_cb(const void *buf, const size_t len, void *arg)
+{
+    (void)arg;
+
+    if (snapshot_len + len > sizeof(snapshot)) {
+        return -ENOSPC;
+    }
+
+    memcpy(&snapshot[snapshot_len], buf, len);
+    snapshot_len += len;
+
+    return 0;
+}
+
+static int snapshot_read_cb(void *buf, const size_t len, void *arg)
+{
+    (void)arg;
+
+    size_t chunk_len = snapshot_len - snapshot_pos;
+
+    if (chunk_len > len) {
+        chunk_len = len;
+    }
+
+    memcpy(buf, &snapshot[snapshot_pos], chunk_len);
+    snapshot_pos += chunk_len;
+
+    return chunk_len;
+}
+
+static void tests_registry_snapshot(void)
+{
+    registry_path_t path_u8 = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                                REGISTRY_SCHEMA_FULL_EXAMPLE_U8);
+    registry_path_t path_string = REGISTRY_PATH_SYS(REGISTRY_SCHEMA_FULL_EXAMPLE, 0,
+                                                    REGISTRY_SCHEMA_FULL_EXAMPLE_STRING);
+
+    registry_set_uint8(path_u8, 42);
+    registry_set_string(path_string, "snapshot");
+
+    snapshot_len = 0;
+    TEST_ASSERT_EQUAL_INT(0, registry_snapshot_write(_REGISTRY_PATH_0(), snapshot_write_cb, NULL));
+
+    registry_set_uint8(path_u8, 0);
+    registry_set_string(path_string, "changed");
+
+    snapshot_pos = 0;
+    TEST_ASSERT_EQUAL_INT(0, registry_snapshot_read(snapshot_read_cb, NULL));
+
+    const uint8_t *output_u8;
+    const char *output_string;
+
+    registry_get_uint8(path_u8, &output_u8);
+    registry_get_string(path_string, &output_string, NULL);
+
+    TEST_ASSERT_EQUAL_INT(42, *output_u8);
+    TEST_ASSERT_EQUAL_STRING("snapshot", output_string);
+}
+#endif /* MODULE_REGISTRY_SNAPSHOT */
+
 static Test *tests_registry(void)
 {
     (void)tests_registry_register_schema;
@@ -500,7 +1095,37 @@ static Test *tests_registry(void)
         new_TestFixture(tests_registry_all_max_values),
         new_TestFixture(tests_registry_commit),
         new_TestFixture(tests_registry_export),
+        new_TestFixture(tests_registry_iter),
+        new_TestFixture(tests_registry_export_page),
+        new_TestFixture(tests_registry_export_missing),
         new_TestFixture(tests_registry_save_load),
+        new_TestFixture(tests_registry_set_from_str),
+        new_TestFixture(tests_registry_convert),
+#if !IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD)
+        new_TestFixture(tests_registry_path_from_names),
+#endif /* !CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD */
+        new_TestFixture(tests_registry_path_pack),
+        new_TestFixture(tests_registry_schema_item),
+        new_TestFixture(tests_registry_load_expected_value),
+#if IS_ACTIVE(CONFIG_REGISTRY_STATS)
+        new_TestFixture(tests_registry_stats),
+#endif /* CONFIG_REGISTRY_STATS */
+#if IS_ACTIVE(CONFIG_REGISTRY_TRACE)
+        new_TestFixture(tests_registry_trace),
+#endif /* CONFIG_REGISTRY_TRACE */
+#if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP)
+        new_TestFixture(tests_registry_load_priority),
+#endif /* CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP */
+#if IS_ACTIVE(CONFIG_REGISTRY_LAZY_LOAD) && IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP)
+        new_TestFixture(tests_registry_lazy_load),
+        new_TestFixture(tests_registry_lazy_load_expected_value),
+#endif /* CONFIG_REGISTRY_LAZY_LOAD && CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_HEAP */
+#if IS_ACTIVE(CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_VFS_AB)
+        new_TestFixture(tests_registry_vfs_ab),
+#endif /* CONFIG_REGISTRY_ENABLE_STORAGE_FACILITY_VFS_AB */
+#if IS_USED(MODULE_REGISTRY_SNAPSHOT)
+        new_TestFixture(tests_registry_snapshot),
+#endif /* MODULE_REGISTRY_SNAPSHOT */
     };
 
     EMB_UNIT_TESTCALLER(registry_tests, test_registry_setup, test_registry_teardown, fixtures);
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2023 HAW Hamburg
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_registry_cli RIOT Registry Tests
+ * @ingroup     sys
+ * @brief       RIOT Registry Tests module providing unit tests for the RIOT Registry sys module
+ * @{
+ *
+ * @file
+ *
+ * @author      Lasse Rosenow <lasse.rosenow@haw-hamburg.de>
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include "embUnit.h"
+#include "registry.h"
+#include "registry_path.h"
+
+#include "registry_tests.h"
+
+static void tests_registry_path_equal(void)
+{
+    /* every macro creates its own arrays, so the paths are compared by value */
+    TEST_ASSERT(registry_path_equal(REGISTRY_PATH_SYS(1, 2, 3, 4), REGISTRY_PATH_SYS(1, 2, 3, 4)));
+
+    TEST_ASSERT(registry_path_equal(_REGISTRY_PATH_0(), _REGISTRY_PATH_0()));
+    TEST_ASSERT(registry_path_equal(REGISTRY_PATH_SYS(1), REGISTRY_PATH_SYS(1)));
+    TEST_ASSERT(!registry_path_equal(REGISTRY_PATH_SYS(1), REGISTRY_PATH_APP(1)));
+    TEST_ASSERT(!registry_path_equal(REGISTRY_PATH_SYS(1, 2, 3), REGISTRY_PATH_SYS(1, 2, 4)));
+
+    /* a parent is not equal to its children */
+    TEST_ASSERT(!registry_path_equal(REGISTRY_PATH_SYS(1, 2), REGISTRY_PATH_SYS(1, 2, 3)));
+    TEST_ASSERT(!registry_path_equal(REGISTRY_PATH_SYS(1, 2, 3, 4), REGISTRY_PATH_SYS(1, 2, 3)));
+}
+
+static void tests_registry_path_is_prefix(void)
+{
+    TEST_ASSERT(registry_path_is_prefix(_REGISTRY_PATH_0(), REGISTRY_PATH_APP(1, 2, 3)));
+    TEST_ASSERT(registry_path_is_prefix(REGISTRY_PATH_SYS(), REGISTRY_PATH_SYS(1, 2, 3)));
+    TEST_ASSERT(registry_path_is_prefix(REGISTRY_PATH_SYS(1, 2), REGISTRY_PATH_SYS(1, 2, 3, 4)));
+    TEST_ASSERT(registry_path_is_prefix(REGISTRY_PATH_SYS(1, 2, 3), REGISTRY_PATH_SYS(1, 2, 3)));
+
+    TEST_ASSERT(!registry_path_is_prefix(REGISTRY_PATH_SYS(), REGISTRY_PATH_APP(1)));
+    TEST_ASSERT(!registry_path_is_prefix(REGISTRY_PATH_SYS(1, 2, 3), REGISTRY_PATH_SYS(1, 2)));
+    TEST_ASSERT(!registry_path_is_prefix(REGISTRY_PATH_SYS(1, 2, 3),
+                                         REGISTRY_PATH_SYS(1, 2, 4, 3)));
+    TEST_ASSERT(!registry_path_is_prefix(REGISTRY_PATH_SYS(1, 2, 3, 4),
+                                         REGISTRY_PATH_SYS(1, 2, 3)));
+}
+
+static void tests_registry_path_cmp(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, registry_path_cmp(REGISTRY_PATH_SYS(1, 2, 3),
+                                               REGISTRY_PATH_SYS(1, 2, 3)));
+
+    /* ids are compared as numbers level by level */
+    TEST_ASSERT(registry_path_cmp(REGISTRY_PATH_SYS(1, 2, 3), REGISTRY_PATH_SYS(1, 2, 4)) < 0);
+    TEST_ASSERT(registry_path_cmp(REGISTRY_PATH_SYS(1, 2, 256), REGISTRY_PATH_SYS(1, 2, 4)) > 0);
+    TEST_ASSERT(registry_path_cmp(REGISTRY_PATH_SYS(2), REGISTRY_PATH_SYS(1, 2, 3)) > 0);
+    TEST_ASSERT(registry_path_cmp(REGISTRY_PATH_SYS(9), REGISTRY_PATH_APP(1)) < 0);
+
+    /* parents come before their children */
+    TEST_ASSERT(registry_path_cmp(_REGISTRY_PATH_0(), REGISTRY_PATH_SYS()) < 0);
+    TEST_ASSERT(registry_path_cmp(REGISTRY_PATH_SYS(1, 2), REGISTRY_PATH_SYS(1, 2, 0)) < 0);
+    TEST_ASSERT(registry_path_cmp(REGISTRY_PATH_SYS(1, 2, 0, 0), REGISTRY_PATH_SYS(1, 2, 0)) > 0);
+}
+
+static void tests_registry_path_hash(void)
+{
+    registry_id_t ids[] = { REGISTRY_ROOT_GROUP_APP, 1, 2, 3, 4 };
+
+    /* the hash covers the ids as one consecutive array */
+    TEST_ASSERT_EQUAL_INT(registry_crc32(0, ids, sizeof(ids)),
+                          registry_path_hash(REGISTRY_PATH_APP(1, 2, 3, 4)));
+    TEST_ASSERT_EQUAL_INT(registry_crc32(0, ids, 2 * sizeof(registry_id_t)),
+                          registry_path_hash(REGISTRY_PATH_APP(1)));
+
+    TEST_ASSERT(registry_path_hash(REGISTRY_PATH_APP(1, 2, 3)) !=
+                registry_path_hash(REGISTRY_PATH_APP(1, 2, 4)));
+    TEST_ASSERT(registry_path_hash(REGISTRY_PATH_APP(1, 2, 3)) !=
+                registry_path_hash(REGISTRY_PATH_SYS(1, 2, 3)));
+}
+
+static Test *tests_registry_path(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(tests_registry_path_equal),
+        new_TestFixture(tests_registry_path_is_prefix),
+        new_TestFixture(tests_registry_path_cmp),
+        new_TestFixture(tests_registry_path_hash),
+    };
+
+    EMB_UNIT_TESTCALLER(registry_path_tests, NULL, NULL, fixtures);
+
+    return (Test *)&registry_path_tests;
+}
+
+int registry_tests_path_run(void)
+{
+    TESTS_START();
+    TESTS_RUN(tests_registry_path());
+    TESTS_END();
+    return 0;
+}
+
+/** @} */
@@ -22,6 +22,8 @@
 #include <stdint.h>
 #include <float.h>
 #include <inttypes.h>
+#include <errno.h>
+#include "embUnit.h"
 #include "fmt.h"
 #include "assert.h"
 #include "ps.h"
@@ -38,6 +40,10 @@
 
 #include "registry_tests.h"
 
+#if IS_USED(MODULE_REGISTRY_SNAPSHOT)
+#include "registry_snapshot.h"
+#endif /* MODULE_REGISTRY_SNAPSHOT */
+
 /* Stack test registry schema */
 #define REGISTRY_APP_SCHEMA_STACK_TEST 15
 
@@ -156,6 +162,16 @@ REGISTRY_SCHEMA(
                         REGISTRY_APP_SCHEMA_STACK_TEST_PARAMETER_LEVEL_5,
                         "parameter_level_5", "A parameter at level 5 nesting.")
 
+                    REGISTRY_GROUP(
+                        REGISTRY_APP_SCHEMA_STACK_TEST_GROUP_LEVEL_5,
+                        "group_level_5", "A group at level 5 nesting.",
+
+                        /* Level 6 nesting */
+                        REGISTRY_PARAMETER_UINT8(
+                            REGISTRY_APP_SCHEMA_STACK_TEST_PARAMETER_LEVEL_6,
+                            "parameter_level_6", "A parameter at level 6 nesting.")
+
+                        )
                     )
                 )
             )
@@ -293,6 +309,58 @@ static registry_id_t parameter_path_level_6[] = {
     REGISTRY_APP_SCHEMA_STACK_TEST_PARAMETER_LEVEL_6,
 };
 
+#if !IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD)
+/* the same paths as above, for registry_path_from_names() */
+static const char *const parameter_names[] = {
+    "app/rgb/stack-test/parameter_level_1",
+    "app/rgb/stack-test/group_level_1/parameter_level_2",
+    "app/rgb/stack-test/group_level_1/group_level_2/parameter_level_3",
+    "app/rgb/stack-test/group_level_1/group_level_2/group_level_3/parameter_level_4",
+    "app/rgb/stack-test/group_level_1/group_level_2/group_level_3/group_level_4/"
+    "parameter_level_5",
+    "app/rgb/stack-test/group_level_1/group_level_2/group_level_3/group_level_4/"
+    "group_level_5/parameter_level_6",
+};
+
+static const char *names;
+#endif /* !CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD */
+
+#if IS_USED(MODULE_REGISTRY_SNAPSHOT)
+static uint8_t snapshot[64];
+static size_t snapshot_len;
+static size_t snapshot_pos;
+
+static int snapshot_write_cb(const void *buf, const size_t len, void *arg)
+{
+    (void)arg;
+
+    if (snapshot_len + len > sizeof(snapshot)) {
+        return -ENOSPC;
+    }
+
+    memcpy(&snapshot[snapshot_len], buf, len);
+    snapshot_len += len;
+
+    return 0;
+}
+
+static int snapshot_read_cb(void *buf, const size_t len, void *arg)
+{
+    (void)arg;
+
+    size_t chunk_len = snapshot_len - snapshot_pos;
+
+    if (chunk_len > len) {
+        chunk_len = len;
+    }
+
+    memcpy(buf, &snapshot[snapshot_pos], chunk_len);
+    snapshot_pos += chunk_len;
+
+    return chunk_len;
+}
+#endif /* MODULE_REGISTRY_SNAPSHOT */
+
 static registry_path_t path = {
     .namespace_id = (registry_namespace_id_t[]) { REGISTRY_ROOT_GROUP_APP },
     .schema_id = (registry_id_t[]) { REGISTRY_APP_SCHEMA_STACK_TEST },
@@ -302,39 +370,74 @@ static registry_path_t path = {
 };
 
 typedef enum {
+    NONE,
     GET,
     SET,
     COMMIT,
     EXPORT,
     SAVE,
     LOAD,
+    ITER,
+    EXPORT_PAGE,
+    SET_FROM_STR,
+    PATH_FROM_NAMES,
+    SNAPSHOT_WRITE,
+    SNAPSHOT_READ,
 } test_case_t;
 
 static void print_test_case_name(test_case_t test_case)
 {
     switch (test_case) {
+    case NONE: {
+        printf("thread baseline:         ");
+    } break;
+
     case GET: {
-        printf("registry_get_value:");
+        printf("registry_get_value:      ");
     } break;
 
     case SET: {
-        printf("registry_set_value:");
+        printf("registry_set_value:      ");
     } break;
 
     case COMMIT: {
-        printf("registry_commit:   ");
+        printf("registry_commit:         ");
     } break;
 
     case EXPORT: {
-        printf("registry_export:   ");
+        printf("registry_export:         ");
     } break;
 
     case SAVE: {
-        printf("registry_save:     ");
+        printf("registry_save:           ");
     } break;
 
     case LOAD: {
-        printf("registry_load:     ");
+        printf("registry_load:           ");
+    } break;
+
+    case ITER: {
+        printf("registry_iter_next:      ");
+    } break;
+
+    case EXPORT_PAGE: {
+        printf("registry_export_page:    ");
+    } break;
+
+    case SET_FROM_STR: {
+        printf("registry_set_from_str:   ");
+    } break;
+
+    case PATH_FROM_NAMES: {
+        printf("registry_path_from_names:");
+    } break;
+
+    case SNAPSHOT_WRITE: {
+        printf("registry_snapshot_write: ");
+    } break;
+
+    case SNAPSHOT_READ: {
+        printf("registry_snapshot_read:  ");
     } break;
     }
 }
@@ -343,9 +446,10 @@ static void *thread_test(void *arg)
 {
     test_case_t test_case = *(test_case_t *)arg;
 
-    int stack_free_before = thread_measure_stack_free(test_thread_stack);
-
     switch (test_case) {
+    case NONE: {
+    } break;
+
     case GET: {
         registry_get_value(path, &test_value);
     } break;
@@ -369,71 +473,169 @@ static void *thread_test(void *arg)
     case LOAD: {
         registry_load(path);
     } break;
-    }
 
+    case ITER: {
+        registry_iter_t iter;
+        registry_iter_entry_t entry;
 
-    int stack_free_after = thread_measure_stack_free(test_thread_stack);
+        registry_iter_init(&iter, path, 1);
+        while (registry_iter_next(&iter, &entry) == 0) {}
+    } break;
 
-    print_test_case_name(test_case);
-    printf(" %d bytes\n", stack_free_before - stack_free_after);
+    case EXPORT_PAGE: {
+        registry_export_token_t token = { 0 };
+
+        while (registry_export_page(test_export_func, path, 1, &token, 1, NULL) == 1) {}
+    } break;
+
+    case SET_FROM_STR: {
+        registry_set_from_str(path, "7");
+    } break;
+
+    case PATH_FROM_NAMES: {
+#if !IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD)
+        registry_id_t ids[REGISTRY_MAX_DIR_DEPTH + 3];
+        registry_path_t names_path;
+
+        registry_path_from_names(names, ids, &names_path);
+#endif /* !CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD */
+    } break;
+
+    case SNAPSHOT_WRITE: {
+#if IS_USED(MODULE_REGISTRY_SNAPSHOT)
+        snapshot_len = 0;
+        registry_snapshot_write(path, snapshot_write_cb, NULL);
+#endif /* MODULE_REGISTRY_SNAPSHOT */
+    } break;
+
+    case SNAPSHOT_READ: {
+#if IS_USED(MODULE_REGISTRY_SNAPSHOT)
+        snapshot_pos = 0;
+        registry_snapshot_read(snapshot_read_cb, NULL);
+#endif /* MODULE_REGISTRY_SNAPSHOT */
+    } break;
+    }
 
     return NULL;
 }
 
-static void create_test_thread(test_case_t test_case)
+/* stack used by a thread that does not call any registry function */
+static size_t baseline_stack_usage = 0;
+
+static size_t measure_stack_usage(test_case_t test_case)
 {
+    /* the test thread has a higher priority than the caller and a freshly painted stack,
+     * so it runs to completion before thread_create() returns and the untouched
+     * part of the stack can be measured afterwards */
     thread_create(test_thread_stack, sizeof(test_thread_stack),
                   THREAD_PRIORITY_MAIN - 1,
                   THREAD_CREATE_STACKTEST,
                   thread_test, &test_case, "test");
+
+    return sizeof(test_thread_stack) - thread_measure_stack_free(test_thread_stack);
 }
 
-static void run_all_tests(void)
+static int run_test(test_case_t test_case)
 {
-    create_test_thread(GET);
-    create_test_thread(SET);
-    create_test_thread(COMMIT);
-    create_test_thread(EXPORT);
-    create_test_thread(SAVE);
-    create_test_thread(LOAD);
+    size_t usage = measure_stack_usage(test_case);
+
+    usage = usage > baseline_stack_usage ? usage - baseline_stack_usage : 0;
+
+    print_test_case_name(test_case);
+    printf(" %d bytes", (int)usage);
+
+    if (usage > CONFIG_REGISTRY_TESTS_STACK_BUDGET) {
+        printf(" exceeds the budget of %d bytes\n", CONFIG_REGISTRY_TESTS_STACK_BUDGET);
+        return 1;
+    }
+
+    printf("\n");
+    return 0;
 }
 
-int registry_tests_stack_run(void)
+static int run_all_tests(void)
 {
-    printf("\nRegistry: Test: Stack consumtions: START\n");
+    int failures = 0;
+
+    failures += run_test(GET);
+    failures += run_test(SET);
+    failures += run_test(COMMIT);
+    failures += run_test(EXPORT);
+    failures += run_test(SAVE);
+    failures += run_test(LOAD);
+    failures += run_test(ITER);
+    failures += run_test(EXPORT_PAGE);
+    failures += run_test(SET_FROM_STR);
+#if !IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD)
+    failures += run_test(PATH_FROM_NAMES);
+#endif /* !CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD */
+#if IS_USED(MODULE_REGISTRY_SNAPSHOT)
+    /* the snapshot that is read is the one that was written before */
+    failures += run_test(SNAPSHOT_WRITE);
+    failures += run_test(SNAPSHOT_READ);
+#endif /* MODULE_REGISTRY_SNAPSHOT */
+
+    return failures;
+}
+
+static int run_level(const size_t level, registry_id_t *parameter_path, const size_t path_len)
+{
+    printf("\nLevel %d:\n", (int)level);
+    path.path = parameter_path;
+    path.path_len = path_len;
+#if !IS_ACTIVE(CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD)
+    names = parameter_names[level - 1];
+#endif /* !CONFIG_REGISTRY_DISABLE_SCHEMA_NAME_FIELD */
+
+    return run_all_tests();
+}
+
+/* amount of functions that exceeded the budget during the last run */
+static int stack_failures;
+
+static void tests_registry_stack_budget(void)
+{
+    int failures = 0;
+
+    baseline_stack_usage = measure_stack_usage(NONE);
+    print_test_case_name(NONE);
+    printf(" %d bytes\n", (int)baseline_stack_usage);
 
-    setup();
+    failures += run_level(1, parameter_path_level_1, ARRAY_SIZE(parameter_path_level_1));
+    failures += run_level(2, parameter_path_level_2, ARRAY_SIZE(parameter_path_level_2));
+    failures += run_level(3, parameter_path_level_3, ARRAY_SIZE(parameter_path_level_3));
+    failures += run_level(4, parameter_path_level_4, ARRAY_SIZE(parameter_path_level_4));
+    failures += run_level(5, parameter_path_level_5, ARRAY_SIZE(parameter_path_level_5));
+    failures += run_level(6, parameter_path_level_6, ARRAY_SIZE(parameter_path_level_6));
 
-    printf("\nLevel 1:\n");
-    path.path = parameter_path_level_1;
-    path.path_len = ARRAY_SIZE(parameter_path_level_1);
-    run_all_tests();
+    stack_failures = failures;
 
-    printf("\nLevel 2:\n");
-    path.path = parameter_path_level_2;
-    path.path_len = ARRAY_SIZE(parameter_path_level_2);
-    run_all_tests();
+    /* every function that exceeds CONFIG_REGISTRY_TESTS_STACK_BUDGET fails the test */
+    TEST_ASSERT_EQUAL_INT(0, failures);
+}
+
+static Test *tests_registry_stack(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(tests_registry_stack_budget),
+    };
 
-    printf("\nLevel 3:\n");
-    path.path = parameter_path_level_3;
-    path.path_len = ARRAY_SIZE(parameter_path_level_3);
-    run_all_tests();
+    EMB_UNIT_TESTCALLER(registry_tests_stack, setup, NULL, fixtures);
 
-    printf("\nLevel 4:\n");
-    path.path = parameter_path_level_4;
-    path.path_len = ARRAY_SIZE(parameter_path_level_4);
-    run_all_tests();
+    return (Test *)&registry_tests_stack;
+}
 
-    printf("\nLevel 5:\n");
-    path.path = parameter_path_level_5;
-    path.path_len = ARRAY_SIZE(parameter_path_level_5);
-    run_all_tests();
+int registry_tests_stack_run(void)
+{
+    printf("\nRegistry: Test: Stack consumtions: START\n");
 
-    (void)parameter_path_level_6;
+    TESTS_START();
+    TESTS_RUN(tests_registry_stack());
+    TESTS_END();
 
     printf("\nRegistry: Test: Stack consumtions: END\n");
 
-    return 0;
+    return stack_failures;
 }
 
 /** @} */
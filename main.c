@@ -7,6 +7,7 @@
 #include "registry_schemas.h"
 #include "registry_cli.h"
 #include "registry_tests.h"
+#include "registry_bench.h"
 #include "registry_storage_facilities.h"
 #include "assert.h"
 #include "vfs.h"
@@ -163,8 +164,10 @@ int demo_app(void)
     registry_register_storage_facility_src(&vfs_instance_1);
     registry_register_storage_facility_dst(&vfs_instance_2);
 
+#if !IS_ACTIVE(CONFIG_REGISTRY_LAZY_LOAD)
     /* load old storage_facility data into registry */
     registry_load(_REGISTRY_PATH_0());
+#endif /* CONFIG_REGISTRY_LAZY_LOAD */
 
     /* DEMO START */
     // int retval;
@@ -202,7 +205,12 @@ int main(void)
 {
     /* test registry */
     registry_tests_api_run();
-    // registry_tests_stack_run();
+    registry_tests_path_run();
+    registry_tests_stack_run();
+
+    /* benchmark registry */
+    // registry_bench_run();
+    // registry_bench_scaling_run();
 
     /* run demo app */
     demo_app();